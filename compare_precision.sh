@@ -0,0 +1,38 @@
+#!/bin/bash
+# Compares the main output of the double build (App) with the single-precision build (App_float).
+#
+# usage: ./compare_precision.sh main_<name>.txt main_<name>_float.txt [first generation]
+#
+# Runs in the two precisions can diverge onto different random trajectories, so rows are not compared one by one. Every
+# column is averaged over all replicas from the given generation on (default: second half of the run), and the two
+# means are printed side by side with their difference.
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 main_<name>.txt main_<name>_float.txt [first generation]"
+    exit 1
+fi
+
+awk -v from="${3:-}" '
+    FNR == 1 { file++; header = 0 }
+    $1 == "Replica" { header = 1; for (i = 1; i <= NF; i++) name[i] = $i; columns = NF; next }
+    header && NF > 2 {
+        rows[file, ++count[file]] = $0
+        if ($2 > last) last = $2
+    }
+    END {
+        if (from == "") from = last / 2
+        for (f = 1; f <= 2; f++) {
+            for (r = 1; r <= count[f]; r++) {
+                n = split(rows[f, r], value, "\t")
+                if (value[2] < from) continue
+                used[f]++
+                for (i = 3; i <= n; i++) sum[f, i] += value[i]
+            }
+        }
+        printf "%-20s %14s %14s %14s\n", "column", "double", "float", "difference"
+        for (i = 3; i <= columns; i++) {
+            a = sum[1, i] / used[1]; b = sum[2, i] / used[2]
+            printf "%-20s %14.4f %14.4f %14.4f\n", name[i], a, b, b - a
+        }
+    }
+' "$1" "$2"
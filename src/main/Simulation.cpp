@@ -1,5 +1,6 @@
 #include "Simulation.h"
 #include "stats/Statistics.h"
+#include "util/Config.h"
 
 
 std::unique_ptr<ResultCache> Simulation::run() {
@@ -17,38 +18,48 @@ std::unique_ptr<ResultCache> Simulation::run() {
 
     for (generation = 1; generation <= parameters->getNumGenerations(); generation++) {
         statistics = std::make_unique<Statistics>(this->parameters);
-        population.reset();
+        arena.reset();
+        population.reset(generation);
 
         population.disperse();
         population.survivalFloaters();
         population.mortalityFloaters();
         population.immigrate();
         population.reassignBreeder();
-        population.help();
-        population.survivalGroup();
+        population.compactGroups();
 
+        const bool recordStatistics = generation % parameters->getSkip() == 0;
 
-        //Calculate stats
-        if (generation % parameters->getSkip() == 0) {
-            statistics->calculateStatistics(population);
+        if (Config::IS_FUSED_GROUP_PASS() && !recordStatistics) {
+            // Nothing looks at the state between survival and mortality in this generation
+            population.helpSurvivalMortality();
+        } else {
+            population.help();
+            population.survivalGroup();
 
-            //Print last generation
-            if (generation == 10000 ||
-                generation == 25000 ||
-                generation == parameters->getNumGenerations() / 2 ||
-                generation == parameters->getNumGenerations()) {
-                results->writeToCacheLastGeneration(this, population);
+
+            //Calculate stats
+            if (recordStatistics) {
+                statistics->calculateStatistics(population);
+
+                //Print last generation
+                if (generation == 10000 ||
+                    generation == 25000 ||
+                    generation == parameters->getNumGenerations() / 2 ||
+                    generation == parameters->getNumGenerations()) {
+                    results->writeToCacheLastGeneration(this, population);
+                }
             }
-        }
 
-        //        if (replica == 0 && generation == 20000){
-        //            std::cout << "HERE" << std::endl; //TODO: Stopper for debugging
-        //        }
+            //        if (replica == 0 && generation == 20000){
+            //            std::cout << "HERE" << std::endl; //TODO: Stopper for debugging
+            //        }
 
-        population.mortalityGroup();
+            population.mortalityGroup();
+        }
 
         // Print main file (separately since we need values of deaths, newBreederFloater, newBreederHelper and inheritance to be calculated)
-        if (generation % parameters->getSkip() == 0) {
+        if (recordStatistics) {
             statistics->printToConsole(generation, population.getDeaths(), population.getEmigrants());
             results->writeToCacheMain(
                 statistics->generateMainCacheElement(generation, population.getDeaths(),
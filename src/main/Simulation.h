@@ -5,6 +5,7 @@
 #include "util/Parameters.h"
 #include "model/Population.h"
 #include "util/ResultCache.h"
+#include "util/Arena.h"
 
 class ResultCache; // Forward declaration of the ResultCache class.
 
@@ -15,6 +16,9 @@ class Simulation {
     // A pointer to the Parameters singleton, which holds the parameters for the simulation.
     std::shared_ptr<Parameters> parameters;
 
+    // Scratch memory for the current generation, reset at the start of every generation.
+    Arena arena;
+
     // The population of individuals in the simulation.
     Population population;
 
@@ -26,7 +30,7 @@ public:
      * Constructor for the Simulation class.
      * @param parameters A shared pointer to the Parameters singleton.
      */
-    explicit Simulation(std::shared_ptr<Parameters> parameters) : parameters(parameters), population(parameters) {
+    explicit Simulation(std::shared_ptr<Parameters> parameters) : parameters(parameters), population(parameters, &arena) {
     }
 
     /**
@@ -1,13 +1,17 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <vector>
 #include "Group.h"
+#include "../util/Config.h"
 
 using namespace std;
 
 
-Group::Group(const std::shared_ptr<Parameters> &parameters) : mainBreeder(BREEDER, parameters), parameters(parameters) {
+Group::Group(const std::shared_ptr<Parameters> &parameters, std::pmr::memory_resource *scratch, int index) :
+        mainBreeder(BREEDER, *parameters), parameters(parameters), scratch(scratch),
+        kernels(&ScenarioKernels::select(*parameters)), index(index) {
     mainBreederAlive = true;
     cumHelp = 0;
     acceptanceRate = Parameters::NO_VALUE;
@@ -19,105 +23,194 @@ Group::Group(const std::shared_ptr<Parameters> &parameters) : mainBreeder(BREEDE
     totalOffspringGroup = 0;
     groupSize = 0;
 
+    members.reserve(parameters->getInitNumHelpers());
     for (int i = 0; i < parameters->getInitNumHelpers(); ++i) {
-        auto individual = Individual(HELPER, parameters);
-        helpers.emplace_back(individual);
+        members.push_back(Individual(HELPER, *parameters));
     }
+    countMember(mainBreeder, 1);
+    countMembers(members, 0, members.size(), 1);
+    joinHelpers(0);
 
     this->calculateGroupSize();
 }
 
 
-/* TOTAL NUMBER OF INDIVIDUALS PER GROUP*/
+/* AGGREGATES */
 
-void Group::calculateGroupSize() {
+namespace {
+    double expulsionEffort(double gamma) {
+        if (gamma < 0) {
+            return 0;
+        } else if (gamma > 1) {
+            return 1;
+        }
+        return gamma;
+    }
+}
+
+Group::Aggregates Group::recomputeAggregates() const {
+    Aggregates sums;
     if (mainBreederAlive) {
-        groupSize = helpers.size() + subordinateBreeders.size() + 1;
-    } else {
-        groupSize = helpers.size() + subordinateBreeders.size();
+        sums.expulsionEffort += expulsionEffort(mainBreeder.getGamma());
+    }
+    const int minAge = parameters->getMinAgeBecomeBreeder();
+    for (size_t i = 0; i < members.size(); i++) {
+        sums.expulsionEffort += expulsionEffort(members.gammas()[i]);
+        if (members.roles()[i] != HELPER) {
+            continue;
+        }
+        sums.help += members.helps()[i];
+        if (members.ages()[i] > minAge - 1) {
+            sums.viableCandidates++;
+            sums.viableCandidateAges += members.ages()[i];
+        }
     }
+    return sums;
 }
 
-/*  DISPERSAL (STAY VS DISPERSE) */
+bool Group::hasConsistentAggregates() const {
+    int breeders = 0;
+    for (size_t i = 0; i < members.size(); i++) {
+        if (members.roles()[i] == BREEDER) {
+            if (members.helps()[i] != 0 || members[i].getDispersal() >= 0) {
+                return false;
+            }
+            breeders++;
+        } else if (members.roles()[i] != HELPER ||
+                   members.helps()[i] != static_cast<Trait>(Individual::computeHelp(members.alphas()[i]))) {
+            return false;
+        }
+    }
+    const Aggregates sums = recomputeAggregates();
+    return breeders == subordinateBreedersSize &&
+           std::abs(aggregates.expulsionEffort - sums.expulsionEffort) <= 1e-9 * (1 + sums.expulsionEffort) &&
+           std::abs(aggregates.help - sums.help) <= 1e-9 * (1 + sums.help) &&
+           aggregates.viableCandidates == sums.viableCandidates &&
+           aggregates.viableCandidateAges == sums.viableCandidateAges;
+}
 
-vector<Individual> Group::disperse() {
+void Group::checkAggregates() const {
+    assert(hasConsistentAggregates());
+}
 
-    vector<Individual> newFloaters;
+void Group::countMembers(const IndividualStore &store, size_t first, size_t last, int sign) {
+    const Trait *gammas = store.gammas();
+    for (size_t i = first; i < last; i++) {
+        aggregates.expulsionEffort += sign * expulsionEffort(gammas[i]);
+    }
+}
 
-    for (int i = 0; i < helpers.size();) {
-        Individual &helper = helpers[i];
+void Group::countMember(const Individual &individual, int sign) {
+    aggregates.expulsionEffort += sign * expulsionEffort(individual.getGamma());
+}
 
-        helper.calcDispersal();
+void Group::countHelpers(const IndividualStore &store, size_t first, size_t last, int sign) {
+    const Trait *helps = store.helps();
+    const int *ages = store.ages();
+    const RoleType *roles = store.roles();
+    const int minAge = parameters->getMinAgeBecomeBreeder();
+    for (size_t i = first; i < last; i++) {
+        if (roles[i] != HELPER) {
+            continue;
+        }
+        aggregates.help += sign * helps[i];
+        if (ages[i] > minAge - 1) {
+            aggregates.viableCandidates += sign;
+            aggregates.viableCandidateAges += sign * ages[i];
+        }
+    }
+}
 
-        if (parameters->uniform(*parameters->getGenerator()) < helper.getDispersal()) {
-            helper.setInherit(false); //the location of the individual is not the natal territory
-            helper.setRoleType(FLOATER);
-            newFloaters.push_back(helper); //add the individual to the vector floaters in the last position
-            helpers.removeIndividual(i);
+void Group::joinHelper(size_t member) {
+    members.helps()[member] = Individual::computeHelp(members.alphas()[member]);
+    countHelpers(members, member, member + 1, 1);
+}
 
-        } else {
-            helper.setRoleType(HELPER); //individuals that stay or disperse to this group become helpers
-            i++;
-        }
+void Group::joinHelpers(size_t first) {
+    const Trait *alphas = members.alphas();
+    Trait *helps = members.helps();
+    for (size_t i = first; i < members.size(); i++) {
+        helps[i] = Individual::computeHelp(alphas[i]);
+    }
+    countHelpers(members, first, members.size(), 1);
+}
 
+void Group::settleAggregates() {
+    if (!hasHelpers()) {
+        aggregates.help = 0;
+    }
+    if (isEmpty()) {
+        aggregates.expulsionEffort = 0;
     }
-    return newFloaters;
 }
 
-int Group::countHelpersAgeOne() {
-    int count = 0;
-    for (Individual &helper: helpers) {
-        if (helper.getAge() == 1) {
-            count++;
-        }
+
+/* TOTAL NUMBER OF INDIVIDUALS PER GROUP*/
+
+void Group::calculateGroupSize() {
+    if (mainBreederAlive) {
+        groupSize = members.size() + 1;
+    } else {
+        groupSize = members.size();
     }
-    return count;
 }
 
-int Group::calculateHelpersToReassign() {
-    int helpersToReassign;
-    if (parameters->isNoRelatedness()) {
-        helpersToReassign = countHelpersAgeOne();
+void Group::setGeneration(int generation) {
+    this->generation = generation;
+}
 
-    } else if (parameters->getReducedRelatedness() == 3) {
+/*  DISPERSAL (STAY VS DISPERSE) */
 
-        helpersToReassign = round(countHelpersAgeOne() / 3);
+void Group::disperse(IndividualStore &floaters) {
 
-    } else if (parameters->getReducedRelatedness() == 2) {
-        double value = static_cast<double>(countHelpersAgeOne()) / 2;
-        if (value != floor(value)) { // Check if the value is not an integer
-            if (parameters->uniform(*parameters->getGenerator()) < 0.5) {
-                helpersToReassign = floor(value);
-            } else {
-                helpersToReassign = ceil(value);
-            }
-        } else {
-            helpersToReassign = value;// If the value is an integer, just assign it normally
+    // Subordinate breeders keep the dispersal NO_VALUE they got as breeders, so they never disperse
+    Trait *dispersals = members.dispersals();
+    const Trait *betas = members.betas();
+    const int *ages = members.ages();
+    const RoleType *roles = members.roles();
+    for (size_t i = 0; i < members.size(); i++) {
+        if (roles[i] == HELPER) {
+            dispersals[i] = Individual::computeDispersal(betas[i], ages[i]);
         }
-    } else {
-        helpersToReassign = 0; // Any other value than 2 or 3 of reduced relatedness will not reassign helpers
     }
-    return helpersToReassign;
-}
 
+    // The dispersers are written straight to the end of the floaters store
+    const size_t firstFloater = floaters.size();
+    UniformBuffer uniforms(stream(RandomPhase::DISPERSAL));
+    members.bernoulliFilter(uniforms, dispersals,
+                            IndividualStore::Removal::IF_BELOW, &floaters, scratch);
+    countMembers(floaters, firstFloater, floaters.size(), -1);
+    countHelpers(floaters, firstFloater, floaters.size(), -1);
+    settleAggregates();
+    checkAggregates();
+
+    for (size_t i = firstFloater; i < floaters.size(); i++) {
+        floaters[i].setInherit(false); //the location of the individual is not the natal territory
+        floaters[i].setRoleType(FLOATER);
+    }
+}
 
-std::vector<Individual> Group::noRelatedHelpersToReassign(int index) {
+size_t Group::noRelatedHelpersToReassign(int index, IndividualStore &noRelatedHelpers) {
 
-    std::vector<Individual> noRelatedHelpers;
+    const size_t firstReassigned = noRelatedHelpers.size();
 
     //Obtain the number of helpers to reassign
-    int helpersToReassign = calculateHelpersToReassign();
+    RandomEngine random = stream(RandomPhase::RELATEDNESS);
+    int helpersToReassign = kernels->helpersToReassign(random, members);
 
     //Reassign the helpers
     for (int i = 0; i < helpersToReassign; i++) {
-        Individual *helper = &helpers.back(); // since offspring are added at the end of the helper vector, access last helper
-        //helper->setInherit(false); //the location of the individual is not the natal territory //TODO: consider reassigned helpers insiders/outsiders?
-        noRelatedHelpers.push_back(*helper); //add the individual to the vector in the last position
-        helper->setGroupIndex(index);
-        assert(helper->getAge() == 1);
-        helpers.pop_back(); // Remove the last helper from the helpers vector
+        auto helper = members.back(); // since offspring are added at the end of the members store, access last helper
+        //helper.setInherit(false); //the location of the individual is not the natal territory //TODO: consider reassigned helpers insiders/outsiders?
+        helper.setGroupIndex(index);
+        assert(helper.getAge() == 1 && helper.getRoleType() == HELPER);
+        noRelatedHelpers.push_back(members, members.size() - 1); //add the individual to the store in the last position
+        members.pop_back(); // Remove the last helper from the members store
     }
-    return noRelatedHelpers;
+    countMembers(noRelatedHelpers, firstReassigned, noRelatedHelpers.size(), -1);
+    countHelpers(noRelatedHelpers, firstReassigned, noRelatedHelpers.size(), -1);
+    settleAggregates();
+    return noRelatedHelpers.size() - firstReassigned;
 }
 
 /*  ACCEPTANCE OF IMMIGRANTS */
@@ -126,26 +219,11 @@ void Group::calcAcceptanceRate() {
 
     this->transferBreedersToHelpers();
 
-    double expulsionEffort = 0;
-    double gamma;
-    double counter = 0;
-
-    if (helpers.empty()) {
+    if (members.empty()) {
         acceptanceRate = 1; //if no group members alive, all immigrants are free to colonise the territory
     } else {
-        for (auto &helper: helpers) {
-            if (helper.getGamma() < 0) {
-                gamma = 0;
-            } else if (helper.getGamma() > 1) {
-                gamma = 1;
-            } else {
-                gamma = helper.getGamma();
-            }
-            expulsionEffort += gamma;
-            counter++;
-        }
-
-        double meanExpulsionEffort = expulsionEffort / counter;
+        // every member is a helper at this point
+        double meanExpulsionEffort = aggregates.expulsionEffort / members.size();
 
         acceptanceRate = 1 - meanExpulsionEffort;
         if (acceptanceRate < 0) { acceptanceRate = 0; }
@@ -153,67 +231,91 @@ void Group::calcAcceptanceRate() {
 }
 
 // Calculates the proportion of floaters that should be considered for immigration into the current group, based on the biasFloatBreeder parameter, the total number of colonies and the acceptance rate of the group.
-std::vector<Individual> Group::getAcceptedFloaters(IndividualVector &floaters) {
-
-// Shuffle the floaters vector
-    std::shuffle(floaters.begin(), floaters.end(), *parameters->getGenerator());
+size_t Group::countAcceptedFloaters(size_t floaters) {
 
 // Take a sample of floaters based on biasFloatBreeder
     int numSampledFloaters = parameters->getFloatersSampledImmigration();
-    if (numSampledFloaters > floaters.size()) {
-        numSampledFloaters = round(floaters.size() / parameters->getMaxColonies());
+    if (numSampledFloaters > static_cast<int>(floaters)) {
+        numSampledFloaters = round(floaters / parameters->getMaxColonies());
     }
-    std::vector<Individual> sampleFloaters(floaters.begin(), floaters.begin() + numSampledFloaters);
 
-    this->hasPotentialImmigrants = !sampleFloaters.empty();
+    this->hasPotentialImmigrants = numSampledFloaters > 0;
 
 // Calculate the number of floaters that should be accepted by the group
     this->calcAcceptanceRate();
-    acceptedFloatersSize = round(sampleFloaters.size() * acceptanceRate);
+    acceptedFloatersSize = round(numSampledFloaters * acceptanceRate);
+    assert(acceptedFloatersSize >= 0 && acceptedFloatersSize <= static_cast<int>(floaters));
+    return acceptedFloatersSize;
+}
 
-// Take a subsample of floaters based on the acceptance rate of the group
-    std::vector<Individual> acceptedFloaters(sampleFloaters.begin(), sampleFloaters.begin() + acceptedFloatersSize);
-    // Remove the selected floaters from the original floaters vector
-    floaters.erase(floaters.begin(), floaters.begin() + acceptedFloatersSize);
+void Group::acceptFloaters(IndividualStore &floaters) {
+    const size_t count = floaters.size();
+    const size_t first = count - countAcceptedFloaters(count);
 
-    return acceptedFloaters;
+// Only the accepted part of the sample joins the group, so only those floaters are drawn, with a partial
+// Fisher-Yates shuffle that moves them to the back of the floaters store: O(accepted) instead of O(floaters)
+    RandomEngine random = stream(RandomPhase::IMMIGRATION);
+    for (size_t i = count; i > first; i--) {
+        floaters.swap(i - 1, Random::bounded(random, static_cast<uint32_t>(i)));
+    }
+
+    // The selected floaters leave the back of the floaters store straight into the members
+    const size_t firstImmigrant = members.size();
+    floaters.moveTail(count - first, members);
+    joinImmigrants(firstImmigrant);
+}
+
+void Group::acceptFloaters(FloaterCohorts &floaters) {
+    const size_t accepted = countAcceptedFloaters(floaters.size());
+
+    const size_t firstImmigrant = members.size();
+    RandomEngine random = stream(RandomPhase::IMMIGRATION);
+    floaters.take(random, accepted, members, parameters->nextId(static_cast<int>(accepted)));
+    joinImmigrants(firstImmigrant);
+}
+
+void Group::joinImmigrants(size_t first) {
+    for (size_t i = first; i < members.size(); i++) {
+        members[i].setRoleType(HELPER);
+    }
+    countMembers(members, first, members.size(), 1);
+    joinHelpers(first);
 }
 
 void Group::transferBreedersToHelpers() {
-    // Move breeders to the helper vector
-    for (auto &breeder: subordinateBreeders) {
-        // Change the role type of the breeder to helper
-        breeder.setRoleType(HELPER);
-        // Add the breeder to the helpers vector
-        helpers.emplace_back(breeder);
+    // Subordinate breeders become helpers where they are
+    if (subordinateBreedersSize > 0) {
+        const RoleType *roles = members.roles();
+        for (size_t i = 0; i < members.size(); i++) {
+            if (roles[i] == BREEDER) {
+                members[i].setRoleType(HELPER);
+                joinHelper(i);
+            }
+        }
+        subordinateBreedersSize = 0;
     }
-    // Clear the breeders vector
-    subordinateBreeders.clear();
+    const size_t firstTransferred = members.size();
 
     // Move the main breeder also to the helper vector
     if (mainBreederAlive) { //TODO: This assumes that the main breeder is chosen again every round, change?
         // Change the fish type of the mainBreeder to helper
         mainBreeder.setRoleType(HELPER);
-        // Add the mainBreeder to the helpers vector
-        helpers.emplace_back(mainBreeder);
+        // Add the mainBreeder to the helpers store
+        members.push_back(mainBreeder);
         // Set mainBreederAlive to false as mainBreeder is no longer a breeder
         mainBreederAlive = false;
     }
+    joinHelpers(firstTransferred);
+    checkAggregates();
 }
 
 /*  CALCULATE CUMULATIVE LEVEL OF HELP */
 
 void Group::calculateCumulativeHelp() //Calculate accumulative help of all individuals inside of each group.
 {
-    cumHelp = 0;
-
-    //Level of help for helpers
-    for (Individual &helper: helpers) {
-        assert(helper.getRoleType() == HELPER);
-        helper.calcHelp();
-        cumHelp += helper.getHelp();
-
-    }
+    // The help of every helper is set when it joins the helpers (see joinHelpers)
+    checkAggregates();
+    cumHelp = std::max(aggregates.help, 0.0); // running sums can round below zero when every helper has help 0
 }
 
 /*  MORTALITY */
@@ -229,52 +331,48 @@ void Group::survivalGroup() {
     };
 
 
-    //Calculate survival for the helpers
-    for (Individual &helper: helpers) {
-        helper.calcSurvival(groupSize, 0, hasPotentialImmigrants);
-    }
-
-    //Calculate the survival for the subordinate breeders
-    for (Individual &breeder: subordinateBreeders) {
-        breeder.calcSurvival(groupSize, 0, hasPotentialImmigrants);
-    }
+    //Calculate survival for the helpers and the subordinate breeders
+    kernels->survival(parameters->getVitalRates(), members, groupSize, hasPotentialImmigrants);
 
     //Calculate the survival of the dominant breeder
-    this->mainBreeder.calcSurvival(groupSize, delta, hasPotentialImmigrants);
+    this->mainBreeder.calcSurvival(*parameters, groupSize, delta, hasPotentialImmigrants);
 }
 
 void Group::mortalityGroup(int &deaths) {
+    UniformBuffer uniforms(stream(RandomPhase::MORTALITY));
 
-    //Mortality helpers
-    this->mortalityGroupVector(deaths, helpers);
-
-    //Mortality subordinate breeders
-    this->mortalityGroupVector(deaths, subordinateBreeders);
+    //Mortality helpers and subordinate breeders
+    this->mortalityMembers(deaths, uniforms);
 
     //Mortality mainBreeder
-    if (mainBreederAlive && parameters->uniform(*parameters->getGenerator()) > mainBreeder.getSurvival()) {
+    if (mainBreederAlive && uniforms() > mainBreeder.getSurvival()) {
         mainBreederAlive = false;
+        countMember(mainBreeder, -1);
         deaths++;
     }
+    settleAggregates();
+    checkAggregates();
     this->calculateGroupSize(); //update group size after mortality
 }
 
-void Group::mortalityGroupVector(int &deaths, IndividualVector &individuals) {
-    vector<Individual, std::allocator<Individual>>::iterator individualsIt;
-    individualsIt = individuals.begin();
-    int size = individuals.size();
-    int counting = 0;
-    while (!individuals.empty() && size > counting) {
-
-        //Mortality of individuals
-        if (parameters->uniform(*parameters->getGenerator()) > individualsIt->getSurvival()) {
-            *individualsIt = individuals[individuals.size() - 1];
-            individuals.pop_back();
-            counting++;
-            deaths++;
-        } else
-            individualsIt++, counting++; //go to next individual
+void Group::mortalityMembers(int &deaths, UniformBuffer &uniforms) {
+    IndividualStore dead(scratch);
+    if (Config::IS_BINOMIAL_MORTALITY() && subordinateBreedersSize == 0 && !members.empty() &&
+        parameters->getVitalRates().isUniformSurvival(HELPER, hasPotentialImmigrants)) {
+        // Everyone is a helper and got the same survival in survivalGroup()
+        const Trait survival = members.survivals()[0];
+        assert(std::all_of(members.survivals(), members.survivals() + members.size(),
+                           [survival](Trait other) { return other == survival; }));
+        deaths += static_cast<int>(members.binomialFilter(uniforms.getEngine(), 1.0 - survival, &dead));
+    } else {
+        deaths += static_cast<int>(members.bernoulliFilter(
+                uniforms, members.survivals(),
+                IndividualStore::Removal::IF_ABOVE, &dead, scratch));
     }
+    countMembers(dead, 0, dead.size(), -1);
+    countHelpers(dead, 0, dead.size(), -1);
+    const RoleType *roles = dead.roles();
+    subordinateBreedersSize -= static_cast<int>(std::count(roles, roles + dead.size(), BREEDER));
 }
 
 
@@ -282,127 +380,154 @@ void Group::mortalityGroupVector(int &deaths, IndividualVector &individuals) {
 
 void Group::reassignBreeders(int &newBreederOutsider, int &newBreederInsider, int &inheritance) {
 
-    if (!helpers.empty()) {
-
-        //select main breeder
-        auto selectedBreeder = selectBreeder(newBreederOutsider, newBreederInsider, inheritance);
-
-        if (selectedBreeder != nullptr) {
-            mainBreeder = *selectedBreeder;
-            mainBreederAlive = true;
-        } else {
-            mainBreederAlive = false;
-        }
-
-
-        //select subordinate breeders
-        this->calcReproductiveShareRate();
-        int reproductiveShare = round(reproductiveShareRate * helpers.size());
-
-        for (int i = 0; i < reproductiveShare; i++) {
-
-            selectedBreeder = selectBreeder(newBreederOutsider, newBreederInsider, inheritance);
-            if (selectedBreeder != nullptr) {
-                subordinateBreeders.emplace_back(*selectedBreeder);
+    if (hasHelpers()) {
+        RandomEngine random = stream(RandomPhase::BREEDER_SELECTION);
+
+        if (parameters->isAgeNoInfluenceInheritance()) {
+            // Every helper old enough to breed has the same chance, so a list of candidates with swap-removal is
+            // enough; the ones old enough to breed come first.
+            std::pmr::vector<int> candidates(scratch);
+            candidates.reserve(members.size());
+            for (size_t i = 0; i < members.size(); i++) {
+                if (breederRank(i) > 0) {
+                    candidates.push_back(static_cast<int>(i));
+                }
             }
+            size_t viable = candidates.size();
+            assert(static_cast<int>(viable) == aggregates.viableCandidates);
+            for (size_t i = 0; i < members.size(); i++) {
+                if (breederRank(i) == 0 && members.roles()[i] == HELPER) {
+                    candidates.push_back(static_cast<int>(i));
+                }
+            }
+            assignBreeders([&]() { return selectScrambleBreeder(random, candidates, viable); },
+                           newBreederOutsider, newBreederInsider, inheritance);
+        } else {
+            // Helpers are drawn with a weight equal to their age if they are old enough to breed; the second tree
+            // only tracks which helpers are still available.
+            const RoleType *roles = members.roles();
+            FenwickTree ranks(members.size(), [this](size_t i) { return breederRank(i); }, scratch);
+            FenwickTree available(members.size(), [roles](size_t i) { return roles[i] == HELPER; }, scratch);
+            assert(ranks.total() == aggregates.viableCandidateAges);
+            assignBreeders([&]() { return selectBreeder(random, ranks, available); },
+                           newBreederOutsider, newBreederInsider, inheritance);
         }
     } else {
         this->calcReproductiveShareRate();
     }
 }
 
+template<class Select>
+void Group::assignBreeders(Select &&selectBreeder, int &newBreederOutsider, int &newBreederInsider,
+                           int &inheritance) {
+    // Selected rows stay where they are and only change role; the main breeder leaves the store at the end
+    size_t remaining = members.size() - subordinateBreedersSize;
 
-Individual *Group::selectBreeder(int &newBreederOutsider, int &newBreederInsider, int &inheritance) {
-    double sumRank = 0;
-    double currentPosition = 0; //age of the previous ind taken from Candidates
-    double RandP = parameters->uniform(*parameters->getGenerator());
-    vector<Individual *> candidates;
-    vector<double> position; //vector of age to choose with higher likelihood the ind with higher age
-    int anyViableCandidate = 0;
-
-
-    Individual *selectedBreeder = nullptr;
+    //select main breeder
+    const int mainBreederRow = selectBreeder();
+    int selectedBreeder = mainBreederRow;
+    if (selectedBreeder != Parameters::NO_VALUE) {
+        promoteToBreeder(selectedBreeder, newBreederOutsider, newBreederInsider, inheritance);
+        remaining--;
+    }
 
-    if (helpers.empty()) {
-        return nullptr;
+    if (mainBreederAlive) {
+        countMember(mainBreeder, -1); // not moved to the helpers this generation, replaced below
+    }
+    if (selectedBreeder != Parameters::NO_VALUE) {
+        mainBreeder = members.toIndividual(selectedBreeder);
+        mainBreederAlive = true;
     } else {
-        //    Join the helpers in the group to the vector candidates
-        for (auto &helper: helpers) {
-            candidates.push_back(&helper);
-            anyViableCandidate += helper.isViableBreeder();
-        }
-
-        //  Check if the candidates meet the age requirements
-        //If none do, take a random candidate
-        if (anyViableCandidate == 0) {
-            std::shuffle(helpers.begin(), helpers.end(), *parameters->getGenerator());
-            selectedBreeder = &helpers.back(); //substitute the previous dead mainBreeder
-            selectedBreeder->setAgeBecomeBreeder();
-            selectedBreeder->setRoleType(BREEDER); //modify the class
-            if (selectedBreeder->isInherit() == false) {
-                newBreederOutsider++;
-            } else {
-                newBreederInsider++;
-                inheritance++; //TODO: At the moment, newBreederInsider and inheritance are equivalent
-            }
-            helpers.pop_back();
+        mainBreederAlive = false;
+    }
 
 
-            //If any does, remove the ones that do not meet them from the candidates vector
-        } else {
-            // remove non-viable candidates
-            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
-                                            [](Individual *candidate) { return !candidate->isViableBreeder(); }),
-                             candidates.end());
+    //select subordinate breeders
+    this->calcReproductiveShareRate();
+    int reproductiveShare = round(reproductiveShareRate * static_cast<double>(remaining));
 
+    for (int i = 0; i < reproductiveShare; i++) {
 
-            //  Choose new breeder
-            //      Choose breeder with higher likelihood for the highest rank
-            vector<Individual *, std::allocator<Individual *>>::iterator candidate;
-            for (candidate = candidates.begin(); candidate < candidates.end(); ++candidate) {
-                sumRank += (*candidate)->getAge(); //add all the ranks from the vector candidates
-            }
+        selectedBreeder = selectBreeder();
+        if (selectedBreeder != Parameters::NO_VALUE) {
+            promoteToBreeder(selectedBreeder, newBreederOutsider, newBreederInsider, inheritance);
+            remaining--;
+            subordinateBreedersSize++;
+        }
+    }
 
-            for (candidate = candidates.begin(); candidate < candidates.end(); ++candidate) {
-                position.push_back(static_cast<double>((*candidate)->getAge()) / static_cast<double>(sumRank) +
-                                   currentPosition); //creates a vector with proportional segments to the rank of each individual
-                currentPosition = position[position.size() - 1];
-            }
+    if (mainBreederRow != Parameters::NO_VALUE) {
+        members.removeIndividual(mainBreederRow); // the last row takes its place
+    }
+    settleAggregates();
+    checkAggregates();
+}
 
 
-            //      Make the chosen candidate the new breeder
-            for (candidate = candidates.begin(); candidate != candidates.end(); ++candidate) {
-                if (RandP < position[candidate - candidates.begin()]) { //chooses the candidate with higher age
+int Group::breederRank(size_t member) const {
+    const int age = members.ages()[member];
+    return members.roles()[member] == HELPER && age > parameters->getMinAgeBecomeBreeder() - 1 ? age : 0;
+}
 
+int Group::selectBreeder(RandomEngine &random, FenwickTree &ranks, FenwickTree &available) {
+    double RandP = Random::uniform(random);
 
-                    selectedBreeder = *candidate;
-                    selectedBreeder->setAgeBecomeBreeder();
-                    selectedBreeder->setRoleType(BREEDER); //modify the class
+    int selectedBreeder = Parameters::NO_VALUE;
 
-                    if ((*candidate)->isInherit() == false) {
-                        newBreederOutsider++;
-                    } else {
-                        newBreederInsider++;
-                        inheritance++; //TODO: At the moment, newBreederInsider and inheritance are equivalent
-                    }
+    if (available.total() == 0) {
+        return Parameters::NO_VALUE;
+    } else {
+        //  Check if the candidates meet the age requirements
+        //If none do, take a random helper
+        if (ranks.total() == 0) {
+            selectedBreeder = available.find(Random::bounded(random, static_cast<uint32_t>(available.total())));
 
+            //If any does, choose among the ones that meet them, with higher likelihood for the highest rank
+        } else {
+            selectedBreeder = ranks.find(static_cast<long>(RandP * ranks.total()));
+        }
 
-                    // Find the iterator pointing to the selected breeder
-                    auto it = std::find(helpers.begin(), helpers.end(), *selectedBreeder);
+        // Draw-and-remove: the selected helper cannot be drawn again
+        ranks.add(selectedBreeder, -breederRank(selectedBreeder));
+        available.add(selectedBreeder, -1);
+    }
+    return selectedBreeder;
+}
 
-                    // Use std::rotate to move the selected breeder to the end of the vector
-                    std::rotate(it, it + 1, helpers.end());
+int Group::selectScrambleBreeder(RandomEngine &random, std::pmr::vector<int> &candidates, size_t &viable) {
+    if (candidates.empty()) {
+        return Parameters::NO_VALUE;
+    }
+    // Draw among the viable candidates if there are any, otherwise among all remaining helpers
+    const size_t range = viable > 0 ? viable : candidates.size();
+    const size_t drawn = Random::bounded(random, static_cast<uint32_t>(range));
+    const int selectedBreeder = candidates[drawn];
+
+    // Swap-removal that keeps the viable candidates in front
+    if (viable > 0) {
+        candidates[drawn] = candidates[viable - 1];
+        candidates[viable - 1] = candidates.back();
+        viable--;
+    } else {
+        candidates[drawn] = candidates.back();
+    }
+    candidates.pop_back();
+    return selectedBreeder;
+}
 
-                    selectedBreeder = &helpers.back();
-                    helpers.pop_back();
-                    break;
-                }
-            }
-        }
+void Group::promoteToBreeder(size_t helper, int &newBreederOutsider, int &newBreederInsider, int &inheritance) {
+    countHelpers(members, helper, helper + 1, -1); // before the role change clears its help
+    auto breeder = members[helper];
+    breeder.setAgeBecomeBreeder();
+    breeder.setRoleType(BREEDER); //modify the class
 
-        assert(selectedBreeder->getRoleType() == BREEDER);
+    if (breeder.isInherit() == false) {
+        newBreederOutsider++;
+    } else {
+        newBreederInsider++;
+        inheritance++; //TODO: At the moment, newBreederInsider and inheritance are equivalent
     }
-    return selectedBreeder;
+    assert(breeder.getRoleType() == BREEDER);
 }
 
 void Group::calcReproductiveShareRate() {
@@ -425,12 +550,17 @@ void Group::calcReproductiveShareRate() {
 /* INCREASE AGE OF ALL GROUP INDIVIDUALS*/
 
 void Group::increaseAge() {
-    for (Individual &helper: helpers) {
-        helper.increaseAge();
-    }
-
-    for (Individual &breeder: subordinateBreeders) {
-        breeder.increaseAge();
+    // Viable candidates stay viable, one year older; helpers reaching the minimum age become viable
+    const int minAge = parameters->getMinAgeBecomeBreeder();
+    aggregates.viableCandidateAges += aggregates.viableCandidates;
+    int *ages = members.ages();
+    const RoleType *roles = members.roles();
+    for (size_t i = 0; i < members.size(); i++) {
+        ages[i]++;
+        if (ages[i] == minAge && roles[i] == HELPER) {
+            aggregates.viableCandidates++;
+            aggregates.viableCandidateAges += ages[i];
+        }
     }
 
     if (mainBreederAlive) {
@@ -441,72 +571,104 @@ void Group::increaseAge() {
 
 /* REPRODUCTION */
 
-void Group::calcFecundity(double mk) {
+void Group::calcFecundity(double mk, RandomEngine &random) {
 
     assert (cumHelp >= 0);
     double initFecundity; //TODO: we store the actual fecundity of the group, no the calculated one, issue for debugging?
 
     if (getBreedersSize() > 0) {
         //Calculate fecundity
-        if (mk > 1 && parameters->isBetHedgingHelp()) { //TODO: Benign environment counted as 1 instead of mOff, change?
-            initFecundity = mk * (parameters->getK0() - parameters->getKh() * cumHelp / (1 + cumHelp) +
-                                  parameters->getKnb() * subordinateBreeders.size() / (1 + subordinateBreeders.size()));
-        } else if (parameters->isHelpObligatory()) {
-            initFecundity = mk * parameters->getK0() + mk * (parameters->getKh() * cumHelp / (1 + cumHelp)) *
-                                                       (1 + (parameters->getKnb() * subordinateBreeders.size() /
-                                                             (1 + subordinateBreeders.size())));
-        } else {
-            initFecundity = mk * (parameters->getK0() + parameters->getKh() * cumHelp / (1 + cumHelp) +
-                                  parameters->getKnb() * subordinateBreeders.size() / (1 + subordinateBreeders.size()));
-        }
+        initFecundity = kernels->fecundity(parameters->getVitalRates(), mk, cumHelp, subordinateBreedersSize);
 
         if (initFecundity < 0) {
             initFecundity = 0;
         }
 
         // Transform fecundity to an integer number
-        std::poisson_distribution<int> PoissonFecundity(initFecundity);
-        fecundityGroup = PoissonFecundity(*parameters->getGenerator()); //integer number
+        fecundityGroup = Random::poisson(random, initFecundity); //integer number
     } else {
         fecundityGroup = 0;
     }
 }
 
 
-void Group::reproduce(int generation, double mk) { // populate offspring generation
+void Group::reproduce(int generation, double mk, const MutationEngine &mutation) { // populate offspring generation
 
-    std::vector<Individual *> breedersPointers;
-    int randomIndex;
-    this->calcFecundity(mk);
+    RandomEngine random = parameters->stream(generation, index, RandomPhase::REPRODUCTION);
+    this->calcFecundity(mk, random);
     offspringMainBreeder = 0;
     offspringSubordinateBreeders = 0;
 
-    for (Individual &breeder: subordinateBreeders) {
-        breedersPointers.push_back(&breeder);
-    }
-    if (mainBreederAlive) {
-        breedersPointers.push_back(&mainBreeder);
-    }
-
-    std::uniform_int_distribution<int> distribution(0, breedersPointers.size() - 1);
-    if (!breedersPointers.empty()) {
-        for (int i = 0; i < fecundityGroup; i++) {
-            // Generate a random index
-            randomIndex = distribution(*parameters->getGenerator());
-            // Access the random individual
-            Individual *randomIndividual = breedersPointers[randomIndex];
-            //Reproduction
-            Individual offspring = Individual(*randomIndividual, HELPER, generation);
-            helpers.emplace_back(offspring);
-            if (randomIndex == breedersPointers.size() - 1) {
-                offspringMainBreeder++;
-            } else {
-                offspringSubordinateBreeders++;
+    // breeders are indexed as the subordinate breeders followed by the main breeder, if alive
+    const int breedersSize = getBreedersSize();
+
+    if (breedersSize > 0) {
+        const size_t firstOffspring = members.size();
+        members.reserve(firstOffspring + fecundityGroup);
+
+        // Every breeder is equally likely to be the parent of each offspring: split the offspring between the main
+        // breeder and the subordinate breeders with one binomial draw, then spread the second share over the
+        // subordinate breeders
+        offspringMainBreeder = mainBreederAlive ? Random::binomial(random, fecundityGroup, 1.0 / breedersSize) : 0;
+        offspringSubordinateBreeders = fecundityGroup - offspringMainBreeder;
+
+        // Rows of the subordinate breeders, in store order
+        std::pmr::vector<size_t> subordinateRows(scratch);
+        subordinateRows.reserve(subordinateBreedersSize);
+        const RoleType *roles = members.roles();
+        for (size_t i = 0; i < firstOffspring; i++) {
+            if (roles[i] == BREEDER) {
+                subordinateRows.push_back(i);
             }
         }
+        assert(subordinateRows.size() == static_cast<size_t>(subordinateBreedersSize));
+
+        // The subordinate share is an equal-probability multinomial sample, drawn as one conditional binomial per
+        // subordinate breeder: each gets its share of the offspring left by the previous ones. Each parent's genome is
+        // cloned once per offspring, and all the offspring are mutated together below
+        int offspringLeft = offspringSubordinateBreeders;
+        int offspringLastBreeder = 0;
+        for (size_t parent = 0; parent < subordinateRows.size() && offspringLeft > 0; parent++) {
+            const size_t breedersLeft = subordinateRows.size() - parent;
+            const int offspring = breedersLeft == 1 ? offspringLeft
+                                                    : Random::binomial(random, offspringLeft, 1.0 / breedersLeft);
+            if (offspring > 0) {
+                members.appendOffspring(members, subordinateRows[parent], offspring, HELPER,
+                                        parameters->nextId(offspring));
+                offspringLeft -= offspring;
+            }
+            if (breedersLeft == 1) {
+                offspringLastBreeder = offspring;
+            }
+        }
+        assert(offspringLeft == 0);
+        if (offspringMainBreeder > 0) {
+            members.appendOffspring(mainBreeder, offspringMainBreeder, HELPER,
+                                    parameters->nextId(offspringMainBreeder));
+        }
+        // The offspring of the last breeder are counted as the main breeder's; when the main breeder is dead, those
+        // are the offspring of the last subordinate breeder
+        if (!mainBreederAlive) {
+            offspringMainBreeder = offspringLastBreeder;
+            offspringSubordinateBreeders = fecundityGroup - offspringMainBreeder;
+        }
+        mutation.mutate(members, firstOffspring, random);
+        countMembers(members, firstOffspring, members.size(), 1);
+        joinHelpers(firstOffspring);
+        checkAggregates();
     }
 }
 
+void Group::settleExtinction() {
+    assert(isEmpty());
+    cumHelp = 0;
+    reproductiveShareRate = Parameters::NO_VALUE;
+    fecundityGroup = 0;
+    offspringMainBreeder = 0;
+    offspringSubordinateBreeders = 0;
+    this->survivalGroup(); // no members left, only sets the group size and the survival of the dead main breeder
+}
+
 
 /* GETTERS */
 
@@ -524,9 +686,9 @@ int Group::getGroupSize() const {
 
 int Group::getBreedersSize() const {
     if (mainBreederAlive) {
-        return subordinateBreeders.size() + 1;
+        return subordinateBreedersSize + 1;
     } else {
-        return subordinateBreeders.size();
+        return subordinateBreedersSize;
     }
 }
 
@@ -564,8 +726,10 @@ std::vector<double> Group::get(Attribute attribute, bool includeBreeder) const {
     if (includeBreeder && isBreederAlive()) {
         result.push_back(mainBreeder.get(attribute));
     }
-    for (const Individual &helper: helpers) {
-        result.push_back(helper.get(attribute));
+    for (auto member: members) {
+        if (member.getRoleType() == HELPER) {
+            result.push_back(member.get(attribute));
+        }
     }
     return result;
 }
@@ -575,33 +739,64 @@ std::vector<double> Group::get(Attribute attribute) const {
 }
 
 
+bool Group::isEmpty() const {
+    return !mainBreederAlive && members.empty();
+}
+
 bool Group::hasHelpers() const {
-    return !helpers.empty();
+    return members.size() > static_cast<size_t>(subordinateBreedersSize);
 }
 
 bool Group::hasSubordinateBreeders() const {
-    return !subordinateBreeders.empty();
+    return subordinateBreedersSize > 0;
 }
 
 void Group::addHelper(Individual &helper) {
     helper.setRoleType(HELPER);
-    this->helpers.emplace_back(helper);
+    this->members.push_back(helper);
+    countMembers(members, members.size() - 1, members.size(), 1);
+    joinHelpers(members.size() - 1);
+}
+
+void Group::addHelper(const IndividualStore &individuals, size_t index) {
+    this->members.push_back(individuals, index);
+    this->members.back().setRoleType(HELPER);
+    countMembers(members, members.size() - 1, members.size(), 1);
+    joinHelpers(members.size() - 1);
+}
+
+const IndividualStore &Group::getMembers() const {
+    return members;
 }
 
-const IndividualVector &Group::getHelpers() const {
-    return helpers;
+IndividualStore Group::getHelpers() const {
+    return filterMembers(HELPER);
 }
 
-const IndividualVector &Group::getSubordinateBreeders() const {
-    return subordinateBreeders;
+IndividualStore Group::getSubordinateBreeders() const {
+    return filterMembers(BREEDER);
 }
 
-void Group::addHelpers(vector<Individual> &helpers) {
-    for (Individual &helper: helpers) {
-        this->addHelper(helper);
+IndividualStore Group::filterMembers(RoleType roleType) const {
+    IndividualStore filtered;
+    const RoleType *roles = members.roles();
+    for (size_t i = 0; i < members.size(); i++) {
+        if (roles[i] == roleType) {
+            filtered.push_back(members, i);
+        }
     }
+    return filtered;
 }
 
+int Group::getSubordinateBreedersSize() const {
+    return subordinateBreedersSize;
+}
+
+std::array<IndividualStore *, 1> Group::getMemberStores() {
+    return {&members};
+}
+
+
 
 
 
@@ -1,10 +1,17 @@
 #ifndef GROUP_AUGMENTATION_GROUP_H
 #define GROUP_AUGMENTATION_GROUP_H
 
+#include <array>
 #include <memory>
+#include <memory_resource>
 #include "Individual.h"
 #include "../util/Parameters.h"
-#include "container/IndividualVector.h"
+#include "../util/UniformBuffer.h"
+#include "../util/FenwickTree.h"
+#include "container/IndividualStore.h"
+#include "container/FloaterCohorts.h"
+#include "Scenario.h"
+#include "MutationEngine.h"
 
 /**
  * @class Group
@@ -17,6 +24,10 @@ class Group {
 
 private:
     std::shared_ptr<Parameters> parameters;
+    std::pmr::memory_resource *scratch; ///< Allocator for containers that only live during the current generation.
+    const ScenarioKernels *kernels; ///< Formulas specialized for the scenario flags of the parameters.
+    int index; ///< Position of the group in the population.
+    int generation = 0; ///< Current generation; with the index, it selects the random streams of the group.
     double cumHelp; ///< The cumulative help provided by the group.
     bool mainBreederAlive; ///< A flag indicating if the main breeder is alive.
     int groupSize; ///< The size of the group.
@@ -31,36 +42,149 @@ private:
 
 
     Individual mainBreeder; ///< The main breeder of the group.
-    IndividualVector subordinateBreeders; ///< A vector of Individual objects that are breeders in the group.
-    IndividualVector helpers; ///< A vector of Individual objects that are helpers in the group.
+    /**
+     * @brief Column store of the helpers and the subordinate breeders of the group, told apart by their role.
+     *
+     * Becoming or ceasing to be a subordinate breeder only changes the role of a row, so the rows do not move between
+     * stores every generation.
+     */
+    IndividualStore members;
+    int subordinateBreedersSize = 0; ///< Rows of the members store with the BREEDER role.
+
+    /**
+     * @brief Group-level sums, updated whenever members join, leave or change role, so that the phases that only need
+     * a sum do not go through the members. Debug builds check them against a full recomputation.
+     */
+    struct Aggregates {
+        double expulsionEffort = 0; ///< Gamma clamped to [0, 1], summed over all members.
+        double help = 0; ///< Help summed over the helpers.
+        int viableCandidates = 0; ///< Helpers old enough to become breeders.
+        long viableCandidateAges = 0; ///< Age summed over those helpers.
+    };
+
+    Aggregates aggregates;
+
+    Aggregates recomputeAggregates() const;
+
+    // Asserts hasConsistentAggregates(), in debug builds only
+    void checkAggregates() const;
+
+    // Adds (sign 1) or subtracts (sign -1) rows [first, last) of a store to the sums over members or over helpers
+    void countMembers(const IndividualStore &store, size_t first, size_t last, int sign);
+
+    void countMember(const Individual &individual, int sign);
+
+    void countHelpers(const IndividualStore &store, size_t first, size_t last, int sign);
+
+    /**
+     * @brief The rows of the members store from @p first on have just become helpers: sets their help and adds them to
+     * the sums over helpers.
+     */
+    void joinHelpers(size_t first);
+
+    /**
+     * @brief Same as above for a single row of the members store.
+     */
+    void joinHelper(size_t member);
+
+    /**
+     * @brief Resets the floating point sums of empty sets to exactly zero after members leave.
+     */
+    void settleAggregates();
+
+
+
+    /**
+     * @brief Weight of a member in the choice of breeders: its age if it is a helper old enough to breed, 0 otherwise.
+     */
+    int breederRank(size_t member) const;
+
+    /**
+     * @brief Draws a breeder among the helpers that are still in @p available, proportionally to age among those old
+     * enough to breed (@p ranks), uniformly if none is, and removes it from both trees.
+     */
+    int selectBreeder(RandomEngine &random, FenwickTree &ranks, FenwickTree &available);
+
+    /**
+     * @brief Scramble competition (AGE_NO_INFLUENCE_INHERITANCE): draws a breeder uniformly among the helpers in
+     * @p candidates, which holds the ones old enough to breed first (@p viable of them), and removes it in O(1).
+     * Falls back to all remaining helpers if none is old enough.
+     */
+    static int selectScrambleBreeder(RandomEngine &random, std::pmr::vector<int> &candidates, size_t &viable);
+
+    /**
+     * @brief Fills the main breeder position and the subordinate breeder positions with helpers given by
+     * @p selectBreeder, which returns Parameters::NO_VALUE once no helper is left.
+     */
+    template<class Select>
+    void assignBreeders(Select &&selectBreeder, int &newBreederOutsider, int &newBreederInsider, int &inheritance);
+
+    /**
+     * @brief Turns the selected helper into a breeder in place; the main breeder leaves the members store at the end
+     * of assignBreeders().
+     */
+    void promoteToBreeder(size_t helper, int &newBreederOutsider, int &newBreederInsider, int &inheritance);
+
+    /**
+     * @brief Mortality of the helpers and the subordinate breeders.
+     */
+    void mortalityMembers(int &deaths, UniformBuffer &uniforms);
+
+    IndividualStore filterMembers(RoleType roleType) const;
 
+    void calcAcceptanceRate();
 
+    /**
+     * @brief The rows of the members store from @p first on are immigrants that just arrived: makes them helpers.
+     */
+    void joinImmigrants(size_t first);
 
-    Individual *selectBreeder(int &newBreederOutsider, int &newBreederInsider, int &inheritance);
+    /**
+     * @brief Sets the acceptance rate and the number of immigrants the group takes from @p floaters floaters.
+     */
+    size_t countAcceptedFloaters(size_t floaters);
 
-    void mortalityGroupVector(int &deaths, IndividualVector &individuals);
+    void calcReproductiveShareRate();
 
-    int countHelpersAgeOne();
+    void calcFecundity(double mk, RandomEngine &random);
 
-    int calculateHelpersToReassign();
+    RandomEngine stream(RandomPhase phase) const {
+        return parameters->stream(generation, index, phase);
+    }
 
-    void calcAcceptanceRate();
+public:
 
-    void calcReproductiveShareRate();
+    explicit Group(const std::shared_ptr<Parameters> &parameters,
+                   std::pmr::memory_resource *scratch = std::pmr::get_default_resource(), int index = 0);
 
-    void calcFecundity(double mk);
+    void setGeneration(int generation);
 
-public:
+    void calculateGroupSize();
 
-    explicit Group(const std::shared_ptr<Parameters>& parameters);
+    // Individuals that leave or join the group go straight from one store to the other, without intermediate stores
 
-    void calculateGroupSize();
+    /**
+     * @brief Moves the helpers that disperse to the end of @p floaters, as floaters.
+     */
+    void disperse(IndividualStore &floaters);
 
-    std::vector<Individual> disperse();
+    /**
+     * @brief Moves the helpers to reassign to another group (see Population::reassignNoRelatedHelpers) to the end of
+     * @p noRelatedHelpers.
+     *
+     * @return The number of moved helpers.
+     */
+    size_t noRelatedHelpersToReassign(int index, IndividualStore &noRelatedHelpers);
 
-    std::vector<Individual> noRelatedHelpersToReassign(int index);
+    /**
+     * @brief Moves the floaters accepted by the group from @p floaters to its helpers.
+     */
+    void acceptFloaters(IndividualStore &floaters);
 
-    std::vector<Individual> getAcceptedFloaters(IndividualVector &floaters);
+    /**
+     * @brief Same as above for a compressed floater pool; the accepted floaters get new ids.
+     */
+    void acceptFloaters(FloaterCohorts &floaters);
 
     void transferBreedersToHelpers();
 
@@ -74,7 +198,23 @@ public:
 
     void increaseAge();
 
-    void reproduce(int generation, double mk);
+    void reproduce(int generation, double mk, const MutationEngine &mutation);
+
+    /**
+     * @brief Leaves an extinct group in the state that reassignBreeders(), calculateCumulativeHelp(), survivalGroup()
+     * and reproduce() would leave it in, so that those phases can skip the group until it is colonized again.
+     *
+     * This includes the survival of the dead main breeder, which is reported with the last generation and depends on
+     * whether the group had potential immigrants, so it is settled again after every immigration that leaves the
+     * group empty.
+     */
+    void settleExtinction();
+
+    /**
+     * @brief Whether the group-level sums and the number of subordinate breeders match a full recomputation over the
+     * members, and every member has the help its role gives it.
+     */
+    bool hasConsistentAggregates() const;
 
 
     // Getters and setters
@@ -101,17 +241,40 @@ public:
     int getTotalOffspringGroup() const;
 
 
+    /**
+     * @brief No main breeder, subordinate breeders or helpers.
+     */
+    bool isEmpty() const;
+
     bool hasHelpers() const;
 
     bool hasSubordinateBreeders() const;
 
     void addHelper(Individual &helper);
 
-    void addHelpers(std::vector<Individual> &helpers);
+    void addHelper(const IndividualStore &individuals, size_t index);
+
+    /**
+     * @brief The helpers and the subordinate breeders, in no particular order; see getHelpers() for the helpers alone.
+     */
+    const IndividualStore &getMembers() const;
+
+    /**
+     * @brief Copy of the helpers, in store order.
+     */
+    IndividualStore getHelpers() const;
+
+    /**
+     * @brief Copy of the subordinate breeders, in store order.
+     */
+    IndividualStore getSubordinateBreeders() const;
 
-    const IndividualVector &getHelpers() const;
+    int getSubordinateBreedersSize() const;
 
-    const IndividualVector &getSubordinateBreeders() const;
+    /**
+     * @brief Stores of the group members other than the main breeder; used to compact the population.
+     */
+    std::array<IndividualStore *, 1> getMemberStores();
 
     std::vector<double> get(Attribute attribute) const;
 
@@ -4,45 +4,22 @@
 
 #include "Individual.h"
 #include "RoleType.h"
+#include "VitalRates.h"
 #include "spdlog/spdlog.h"
 
-//Constructor for reproduction of a Breeder
-Individual::Individual(Individual &individual, RoleType roleType, int &generation) : parameters(individual.parameters) {
-
-    if (individual.roleType != BREEDER) {
-        spdlog::error("only breeders can reproduce");
-    }
-
-    assert(individual.roleType == BREEDER);
-
-    this->alpha = individual.alpha;
-    this->beta = individual.beta;
-    this->gamma = individual.gamma;
-    this->delta = individual.delta;
-    this->drift = individual.getDrift();
-
-    this->dispersal = Parameters::NO_VALUE;
-    this->help = Parameters::NO_VALUE;
-    this->fecundity = Parameters::NO_VALUE;
-
-    this->initializeIndividual(roleType);
-
-    this->mutate(generation);
-}
-
 //Constructor for initial creation
-Individual::Individual(RoleType roleType, const std::shared_ptr<Parameters> &parameters) : parameters(parameters) {
-
+Individual::Individual(RoleType roleType, Parameters &parameters) {
 
-    this->alpha = parameters->getInitAlpha();
-    this->beta = parameters->getInitBeta();
-    this->gamma = parameters->getInitGamma();
-    this->delta = parameters->getInitDelta();
-    this->drift = parameters->driftUniform(*parameters->getGenerator());
-    this->initializeIndividual(roleType);
+    this->alpha = parameters.getInitAlpha();
+    this->beta = parameters.getInitBeta();
+    this->gamma = parameters.getInitGamma();
+    this->delta = parameters.getInitDelta();
+    this->drift = Random::uniform(*parameters.getGenerator(), 100, 200);
+    this->groupIndex = Parameters::NO_VALUE;
+    this->initializeIndividual(roleType, parameters);
 }
 
-void Individual::initializeIndividual(RoleType type) {
+void Individual::initializeIndividual(RoleType type, Parameters &parameters) {
     this->dispersal = Parameters::NO_VALUE;
     this->help = 0;
     this->survival = Parameters::NO_VALUE;
@@ -50,7 +27,7 @@ void Individual::initializeIndividual(RoleType type) {
     this->inherit = true;
     this->age = 1;
     this->ageBecomeBreeder = Parameters::NO_VALUE;
-    this->id = parameters->nextId();
+    this->id = parameters.nextId();
 
 }
 
@@ -61,44 +38,45 @@ void Individual::setGroupIndex(int groupIndex) {
 
 /* BECOME FLOATER (STAY VS DISPERSE) */
 
-void Individual::calcDispersal() {
+double Individual::computeDispersal(double beta, int age) {
     if (age == 1) {
-        this->dispersal = beta;
-        if (this->dispersal > 1) { this->dispersal = 1; } else if (this->dispersal < 0.5) { this->dispersal = 0.5; }
-
+        double dispersal = beta;
+        if (dispersal > 1) { dispersal = 1; } else if (dispersal < 0.5) { dispersal = 0.5; }
+        return dispersal;
     } else {
-        this->dispersal = 0;
+        return 0;
     }
 }
 
 /*DISPLAY LEVEL OF HELP*/
 
-void Individual::calcHelp() {
-    if (roleType == HELPER) {
-        help = alpha;
-        if (help < 0) { help = 0; }
-    } else {
-        help = Parameters::NO_VALUE;
-        spdlog::error("floaters get a help value");
-    }
+double Individual::computeHelp(double alpha) {
+    return alpha < 0 ? 0 : alpha;
 }
 
 
 /*SURVIVAL*/
 
-void Individual::calcSurvival(const int &groupSize, double delta, const bool &hasPotentialImmigrants) {
+void Individual::calcSurvival(const Parameters &parameters, int groupSize, double delta, bool hasPotentialImmigrants) {
+    this->survival = parameters.getVitalRates().survival(getRoleType(), groupSize, help, gamma, delta,
+                                                         hasPotentialImmigrants);
+}
+
+double Individual::computeSurvival(const Parameters &parameters, RoleType roleType, int groupSize, double help,
+                                   double gamma, double delta, bool hasPotentialImmigrants) {
 
     double thisGroupSize;
     double Xn, Xe, Xh, Xrs, X0, X1;
+    double survival;
 
-    if (parameters->isNoGroupAugmentation()) {
-        thisGroupSize = parameters->getFixedGroupSize();
+    if (parameters.isNoGroupAugmentation()) {
+        thisGroupSize = parameters.getFixedGroupSize();
     } else {
         thisGroupSize = groupSize;
     }
 
-    X0 = parameters->getX0();           // min survival
-    X1 = 1 - X0 - parameters->getM(); //  X0 + X1 max survival
+    X0 = parameters.getX0();           // min survival
+    X1 = 1 - X0 - parameters.getM(); //  X0 + X1 max survival
     if (X1 < 0) { X1 = 0; }
 
     if (roleType == FLOATER) {
@@ -107,29 +85,31 @@ void Individual::calcSurvival(const int &groupSize, double delta, const bool &ha
         Xh = 0;     // effect of help
         Xrs = 0;    // effect of reproductive suppression
     } else if (roleType == BREEDER) {
-        Xn = parameters->getXn();
-        Xe = parameters->getXe();
+        Xn = parameters.getXn();
+        Xe = parameters.getXe();
         Xh = 0;
-        Xrs = parameters->getXrs();
+        Xrs = parameters.getXrs();
     } else { //HELPER
-        Xn = parameters->getXn();
-        Xe = parameters->getXe();
-        Xh = parameters->getXh();
+        Xn = parameters.getXn();
+        Xe = parameters.getXe();
+        Xh = parameters.getXh();
         Xrs = 0;
     }
 
-    const double gamma = hasPotentialImmigrants ? this->gamma : 0; // no cost of expulsion if no potential immigrants
+    if (!hasPotentialImmigrants) {
+        gamma = 0; // no cost of expulsion if no potential immigrants
+    }
 
     if (Xn + Xe + Xh + Xrs == 0) { //prevent to divide by 0
-        this->survival = X0;
+        survival = X0;
 
         if (roleType == FLOATER) {
-            this->survival = X0 + (X1 / 2) + parameters->getXf(); // effect of environment (X1) + exp(0) + additional survival/mortality defined by Xf
+            survival = X0 + (X1 / 2) + parameters.getXf(); // effect of environment (X1) + exp(0) + additional survival/mortality defined by Xf
         }
     } else {
-        this->survival = X0 + ((Xn * X1 / (1 + exp(-thisGroupSize))) + (Xh * X1 / (1 + exp(this->help))) +
-                               (Xe * X1 / (1 + exp(gamma))) + (Xrs * X1 / (1 + exp(delta)))) /
-                              (Xn + Xe + Xh + Xrs);
+        survival = X0 + ((Xn * X1 / (1 + exp(-thisGroupSize))) + (Xh * X1 / (1 + exp(help))) +
+                         (Xe * X1 / (1 + exp(gamma))) + (Xrs * X1 / (1 + exp(delta)))) /
+                        (Xn + Xe + Xh + Xrs);
     }
 
     if (survival < 0 && survival > 1) {
@@ -138,56 +118,9 @@ void Individual::calcSurvival(const int &groupSize, double delta, const bool &ha
 
 
     assert(survival >= 0 && survival <= 1);
-    if (this->survival > 0.95) { this->survival = 0.95; }
-    else if (this->survival < 0) { this->survival = 0; } //prevent survival to be close to 1 or negative
-}
-
-
-/*REPRODUCTION*/
-
-void Individual::mutate(int generation) // mutate genome of offspring
-{
-    auto rng = *parameters->getGenerator();
-    std::normal_distribution<double> NormalA(0, parameters->getStepAlpha());
-    std::normal_distribution<double> NormalB(0, parameters->getStepBeta());
-    std::normal_distribution<double> NormalG(0, parameters->getStepGamma());
-    std::normal_distribution<double> NormalD(0, parameters->getStepDelta());
-    std::normal_distribution<double> NormalDrift(0, parameters->getStepDrift());
-
-    // Alpha
-    double mutationAlpha;
-
-    if (parameters->isEvolutionHelpAfterDispersal() && generation < 25000) {
-        mutationAlpha = 0;
-    } else {
-        mutationAlpha = parameters->getMutationAlpha();
-    }
-
-    if (parameters->uniform(rng) < mutationAlpha) {
-        alpha += NormalA(rng);
-    }
-
-    // Beta
-    if (parameters->uniform(rng) < parameters->getMutationBeta()) {
-        beta += NormalB(rng);
-    }
-
-    // Gamma
-    if (parameters->uniform(rng) < parameters->getMutationGamma()) {
-        gamma += NormalG(rng);
-    }
-
-
-    //Delta
-    if (parameters->uniform(rng) < parameters->getMutationDelta()) {
-        delta += NormalD(rng);
-    }
-
-
-    // Drift
-    if (parameters->uniform(rng) < parameters->getMutationDrift()) {
-        drift += NormalDrift(rng);
-    }
+    if (survival > 0.95) { survival = 0.95; }
+    else if (survival < 0) { survival = 0; } //prevent survival to be close to 1 or negative
+    return survival;
 }
 
 
@@ -209,48 +142,44 @@ void Individual::increaseAge() {
 
 /* GETTERS AND SETTERS */
 
-double Individual::getAlpha() const {
+Trait Individual::getAlpha() const {
     return alpha;
 }
 
-double Individual::getBeta() const {
+Trait Individual::getBeta() const {
     return beta;
 }
 
-double Individual::getGamma() const {
+Trait Individual::getGamma() const {
     return gamma;
 }
 
-double Individual::getDelta() const {
+Trait Individual::getDelta() const {
     return delta;
 }
 
-double Individual::getDrift() const {
+Trait Individual::getDrift() const {
     return drift;
 }
 
-double Individual::getDispersal() const {
+Trait Individual::getDispersal() const {
     return dispersal;
 }
 
-double Individual::getHelp() const {
+Trait Individual::getHelp() const {
     return help;
 }
 
-double Individual::getSurvival() const {
+Trait Individual::getSurvival() const {
     return survival;
 }
 
-double Individual::getFecundity() const {
-    return fecundity;
-}
-
 RoleType Individual::getRoleType() const {
-    return roleType;
+    return static_cast<RoleType>(roleType);
 }
 
 void Individual::setRoleType(RoleType type) {
-    Individual::roleType = type;
+    this->roleType = type;
     if (type == BREEDER) {
         this->dispersal = Parameters::NO_VALUE;
         this->help = 0;
@@ -265,7 +194,7 @@ int Individual::getAge() const {
 }
 
 void Individual::setAgeBecomeBreeder() {
-    Individual::ageBecomeBreeder = this->age;
+    this->ageBecomeBreeder = this->age;
 }
 
 bool Individual::isInherit() const {
@@ -273,7 +202,7 @@ bool Individual::isInherit() const {
 }
 
 void Individual::setInherit(bool inherit) {
-    Individual::inherit = inherit;
+    this->inherit = inherit;
 }
 
 double Individual::get(Attribute type) const {
@@ -299,25 +228,18 @@ double Individual::get(Attribute type) const {
         case AGE_BECOME_BREEDER:
             return this->ageBecomeBreeder;
         case FECUNDITY:
-            return this->fecundity;
+            return Parameters::NO_VALUE; // fecundity is tracked per group
 
     }
 
     assert(false);
+    return Parameters::NO_VALUE;
 }
 
 int Individual::getGroupIndex() const {
     return groupIndex;
 }
 
-bool Individual::isViableBreeder() {
-    if (age > parameters->getMinAgeBecomeBreeder() - 1) {
-        return true;
-    } else {
-        return false;
-    }
-}
-
 bool Individual::operator==(const Individual &other) const {
     return (this->id == other.id);
 }
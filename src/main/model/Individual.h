@@ -1,11 +1,14 @@
 #ifndef GROUP_AUGMENTATION_INDIVIDUAL_H
 #define GROUP_AUGMENTATION_INDIVIDUAL_H
 
-#include <unordered_map>
-#include <memory>
+#include <type_traits>
 #include "RoleType.h"
 #include "../util/Parameters.h"
 #include "Attribute.h"
+#include "Trait.h"
+
+template<class Scalar>
+class BasicIndividualStore;
 
 /**
  * @class Individual
@@ -17,63 +20,71 @@
 class Individual {
 
 private:
-    std::shared_ptr<Parameters> parameters;
-    double id; ///< The unique identifier of the individual.
-    double alpha; ///< Genetic parameter alpha.
-    double beta; ///< Genetic parameter beta.
-    double gamma; ///< Genetic parameter gamma.
-    double delta; ///< Genetic parameter delta.
-    double drift; ///< Genetic parameter drift.
-
-    double dispersal; ///< The dispersal rate of the individual.
-    double help; ///< The help provided by the individual.
-    double survival; ///< The survival rate of the individual.
-
-    RoleType roleType; ///< The type of the individual (breeder, helper, floater).
-    int age; ///< The age of the individual.
-    int ageBecomeBreeder; ///< The age at which the individual became a breeder.
-    bool inherit; ///< Flag indicating if the individual inherited the territory or dispersed.
-    double fecundity;
-    int groupIndex; ///< The index of the group the individual belongs to.
+    Trait alpha; ///< Genetic parameter alpha.
+    Trait beta; ///< Genetic parameter beta.
+    Trait gamma; ///< Genetic parameter gamma.
+    Trait delta; ///< Genetic parameter delta.
+    Trait drift; ///< Genetic parameter drift.
 
+    Trait dispersal; ///< The dispersal rate of the individual.
+    Trait help; ///< The help provided by the individual.
+    Trait survival; ///< The survival rate of the individual.
 
+    int id; ///< The unique identifier of the individual.
+    int groupIndex; ///< The index of the group the individual belongs to.
+    int ageBecomeBreeder; ///< The age at which the individual became a breeder.
+    int age: 29; ///< The age of the individual, NO_VALUE for a dead main breeder.
+    unsigned int roleType: 2; ///< The type of the individual (breeder, helper, floater).
+    unsigned int inherit: 1; ///< Flag indicating if the individual inherited the territory or dispersed.
 
-    void mutate(int generation);
+    void initializeIndividual(RoleType type, Parameters &parameters);
 
-    void initializeIndividual(RoleType type);
+    Individual() = default; // used by IndividualStore to materialize a stored row
 
 public:
 
-    Individual(RoleType roleType, const std::shared_ptr<Parameters> &parameters);
-
-    Individual(Individual &individual, RoleType roleType, int &generation);
+    Individual(RoleType roleType, Parameters &parameters);
 
     bool operator==(const Individual &other) const;
 
     int getGroupIndex() const;
 
-    void calcDispersal();
+    void calcSurvival(const Parameters &parameters, int groupSize, double delta, bool hasPotentialImmigrants);
+
+    /**
+     * @brief Dispersal propensity for a given beta and age; only individuals of age 1 disperse.
+     */
+    static double computeDispersal(double beta, int age);
 
-    void calcHelp();
+    /**
+     * @brief Level of help displayed by a helper with the given alpha.
+     */
+    static double computeHelp(double alpha);
 
-    void calcSurvival(const int &groupSize, double delta, const bool &hasPotentialImmigrants);
+    /**
+     * @brief Survival probability of an individual of the given role, evaluated straight from the parameters.
+     *
+     * Reference for VitalRates::survival, which the simulation uses.
+     */
+    static double computeSurvival(const Parameters &parameters, RoleType roleType, int groupSize, double help,
+                                  double gamma, double delta, bool hasPotentialImmigrants);
 
     // Getters and setters
-    double getAlpha() const;
+    Trait getAlpha() const;
 
-    double getBeta() const;
+    Trait getBeta() const;
 
-    double getGamma() const;
+    Trait getGamma() const;
 
-    double getDelta() const;
+    Trait getDelta() const;
 
-    double getDrift() const;
+    Trait getDrift() const;
 
-    double getDispersal() const;
+    Trait getDispersal() const;
 
-    double getHelp() const;
+    Trait getHelp() const;
 
-    double getSurvival() const;
+    Trait getSurvival() const;
 
     RoleType getRoleType() const;
 
@@ -93,11 +104,13 @@ public:
 
     void setGroupIndex(int groupIndex);
 
-    bool isViableBreeder();
-
-    double getFecundity() const; //TODO: remove all individual fecundities
-
+    template<class Scalar>
+    friend class BasicIndividualStore;
 };
 
+// Individuals are copied around by value in every phase of a generation, so they must stay plain records
+static_assert(std::is_trivially_copyable_v<Individual>, "Individual must be trivially copyable");
+static_assert(sizeof(Individual) <= 8 * sizeof(Trait) + 4 * sizeof(int), "Individual is larger than expected");
+
 
 #endif //GROUP_AUGMENTATION_INDIVIDUAL_H
\ No newline at end of file
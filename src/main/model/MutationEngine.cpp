@@ -0,0 +1,52 @@
+#include <cmath>
+#include "MutationEngine.h"
+
+MutationEngine::MutationEngine(const Parameters &parameters) {
+    loci[0].column = &IndividualStore::alphas;
+    loci[0].step = parameters.getStepAlpha();
+    loci[1].column = &IndividualStore::betas;
+    loci[1].step = parameters.getStepBeta();
+    loci[2].column = &IndividualStore::gammas;
+    loci[2].step = parameters.getStepGamma();
+    loci[3].column = &IndividualStore::deltas;
+    loci[3].step = parameters.getStepDelta();
+    loci[4].column = &IndividualStore::drifts;
+    loci[4].step = parameters.getStepDrift();
+
+    setRate(loci[0], parameters.getMutationAlpha());
+    setRate(loci[1], parameters.getMutationBeta());
+    setRate(loci[2], parameters.getMutationGamma());
+    setRate(loci[3], parameters.getMutationDelta());
+    setRate(loci[4], parameters.getMutationDrift());
+}
+
+void MutationEngine::setRate(Locus &locus, double rate) {
+    locus.rate = rate;
+    if (rate > 0 && rate < 1) {
+        locus.logFailure = std::log1p(-rate);
+    }
+}
+
+void MutationEngine::setMutationAlpha(double rate) {
+    setRate(loci[0], rate);
+}
+
+long MutationEngine::drawGap(const Locus &locus, RandomEngine &generator) {
+    if (locus.rate >= 1) {
+        return 0;
+    }
+    return Random::geometric(generator, locus.logFailure);
+}
+
+void MutationEngine::mutate(IndividualStore &offspring, size_t first, RandomEngine &generator) const {
+    const long count = static_cast<long>(offspring.size() - first);
+    for (const Locus &locus: loci) {
+        if (locus.rate <= 0) {
+            continue;
+        }
+        Trait *values = (offspring.*locus.column)() + first;
+        for (long next = drawGap(locus, generator); next < count; next += 1 + drawGap(locus, generator)) {
+            values[next] += Random::normal(generator, 0, locus.step);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef GROUP_AUGMENTATION_MUTATIONENGINE_H
+#define GROUP_AUGMENTATION_MUTATIONENGINE_H
+
+#include <array>
+#include "../util/Parameters.h"
+#include "container/IndividualStore.h"
+
+/**
+ * @class MutationEngine
+ * @brief Mutates offspring genomes by jumping from one mutation to the next instead of testing every locus.
+ *
+ * Each locus (alpha, beta, gamma, delta, drift) sees the offspring of a group as one sequence of Bernoulli trials
+ * with the mutation rate of that locus. The gap to the next mutated offspring is drawn from a geometric distribution,
+ * and a normal step is only drawn for the offspring that actually mutate. Each call starts new sequences, so the
+ * mutations of a group only depend on the random stream it is given.
+ */
+class MutationEngine {
+
+    struct Locus {
+        Trait *(IndividualStore::*column)();
+        double rate = 0;
+        double logFailure = 0; ///< log(1 - rate), see Random::geometric.
+        double step = 0; ///< Standard deviation of a mutation.
+    };
+
+    std::array<Locus, 5> loci;
+
+    static long drawGap(const Locus &locus, RandomEngine &generator);
+
+    void setRate(Locus &locus, double rate);
+
+public:
+
+    explicit MutationEngine(const Parameters &parameters);
+
+    /**
+     * @brief Sets the mutation rate of alpha, which can change between generations (see ScenarioKernels).
+     */
+    void setMutationAlpha(double rate);
+
+    /**
+     * @brief Mutates the genomes of the rows of @p offspring starting at @p first.
+     */
+    void mutate(IndividualStore &offspring, size_t first, RandomEngine &generator) const;
+};
+
+
+#endif //GROUP_AUGMENTATION_MUTATIONENGINE_H
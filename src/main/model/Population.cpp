@@ -1,14 +1,30 @@
 #include "Population.h"
+#include "../util/Config.h"
+#include <cassert>
 #include <vector>
+#include <algorithm>
+#include <numeric>
 
 const std::vector<Group> &Population::getGroups() const {
     return groups;
 }
 
-const IndividualVector &Population::getFloaters() const {
+const std::vector<int> &Population::getActiveGroups() const {
+    return activeGroups;
+}
+
+const IndividualStore &Population::getFloaters() const {
+    if (compressedFloaters && !floatersExpanded) {
+        floaterCohorts.expand(floaters);
+        floatersExpanded = true;
+    }
     return floaters;
 }
 
+size_t Population::floaterCount() const {
+    return compressedFloaters ? floaterCohorts.size() : floaters.size();
+}
+
 int Population::getDeaths() const {
     return deaths;
 }
@@ -17,7 +33,11 @@ int Population::getEmigrants() const {
     return emigrants;
 }
 
-void Population::reset() {
+void Population::reset(int generation) {
+    this->generation = generation;
+    for (Group &group: groups) {
+        group.setGeneration(generation);
+    }
     this->deaths = 0;
     this->inheritance = 0;
     this->newBreederInsider = 0;
@@ -26,168 +46,273 @@ void Population::reset() {
     this->groupColonization = 0;
 }
 
-Population::Population(const std::shared_ptr<Parameters> &parameters) : parameters(parameters), deaths(0),
-                                                                        groupColonization(0),
-                                                                        newBreederOutsider(0),
-                                                                        newBreederInsider(0),
-                                                                        inheritance(0),
-                                                                        emigrants(0), mk(0) {
+Population::Population(const std::shared_ptr<Parameters> &parameters, std::pmr::memory_resource *scratch) :
+        parameters(parameters),
+        scratch(scratch),
+        kernels(&ScenarioKernels::select(*parameters)),
+        mutation(*parameters),
+        compressedFloaters(Config::IS_COMPRESSED_FLOATERS()),
+        deaths(0),
+        groupColonization(0),
+        newBreederOutsider(0),
+        newBreederInsider(0),
+        inheritance(0),
+        emigrants(0), mk(0) {
     for (int i = 0; i < parameters->getMaxColonies(); i++) {
-        Group group(parameters);
+        Group group(parameters, scratch, i);
         this->groups.emplace_back(group);
+        if (!groups.back().isEmpty()) {
+            activeGroups.push_back(i);
+        }
+    }
+    isActive.assign(groups.size(), false);
+    for (int i: activeGroups) {
+        isActive[i] = true;
+    }
+    for (Group &group: groups) {
+        for (IndividualStore *store: group.getMemberStores()) {
+            memberStores.push_back(store);
+        }
     }
 }
 
 void Population::disperse() {
-    for (auto &group: groups) {
-        this->floaters.merge(group.disperse());
+    if (compressedFloaters) {
+        IndividualStore dispersers(scratch);
+        for (int i: activeGroups) {
+            groups[i].disperse(dispersers);
+        }
+        floaterCohorts.add(dispersers, scratch);
+        floatersExpanded = false;
+    } else {
+        for (int i: activeGroups) {
+            groups[i].disperse(this->floaters);
+        }
     }
-    this->emigrants = floaters.size();
+    this->emigrants = static_cast<int>(floaterCount());
     // After all floater are created, the number of emigrants is set to the number of floaters.
 
     this->reassignNoRelatedHelpers();
 }
 
 void Population::reassignNoRelatedHelpers() {
-    int groupID = 0;
-
-    std::vector<Individual> noRelatedHelpers;
-    IndividualVector allNoRelatedHelpers;
-    std::vector<int> noRelatednessGroupsID;
+    IndividualStore allNoRelatedHelpers(scratch);
 
     // Helpers just born are reassigned to random groups. Groups receive as many helpers as helpers left the group for reassignment.
-    for (int i = 0; i < groups.size(); i++) {
-        Group &group = groups[i];
+    for (int groupID: activeGroups) {
+        Group &group = groups[groupID];
 
-        noRelatedHelpers = group.noRelatedHelpersToReassign(i);
-        for (int j = 0; j < noRelatedHelpers.size(); j++) {
-            noRelatednessGroupsID.push_back(groupID);
-        }
-        allNoRelatedHelpers.merge(noRelatedHelpers);
-        groupID++;
+        group.noRelatedHelpersToReassign(groupID, allNoRelatedHelpers);
     }
 
     // Assign helpers to random group while maintaining the same group size
     if (!allNoRelatedHelpers.empty()) {
-        int selectGroupID;
-        int timeout = 0;
-        while (!allNoRelatedHelpers.empty()) {
-            int selectGroupIndex = 0;
-            if (noRelatednessGroupsID.size() > 1) {
-                std::uniform_int_distribution<int> uniformIntDistribution(0, noRelatednessGroupsID.size() - 1);
-                selectGroupIndex = uniformIntDistribution(
-                        *parameters->getGenerator()); // selects a random index the noRelatednessGroupsID vector
+        RandomEngine random = parameters->stream(generation, Parameters::NO_VALUE, RandomPhase::RELATEDNESS);
+
+        // Each helper takes one receiving slot, and every group offers one slot per helper it gave, so every group
+        // receives as many helpers as it gave. The slots are shuffled, and a helper whose slot is its own group swaps
+        // slots with the first helper, from a random position on, for which the swap sends neither helper home.
+        // If one group gave more than half of the helpers, no such swap is left once as few of its helpers as
+        // possible go back to it, and the rest of them stay home.
+        const size_t count = allNoRelatedHelpers.size();
+        std::pmr::vector<int> slots(scratch);
+        slots.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            slots.push_back(allNoRelatedHelpers[i].getGroupIndex());
+        }
+        Random::shuffle(slots.begin(), slots.end(), random);
+
+        int stuckGroup = Parameters::NO_VALUE; // a group whose helpers found no swap, only a dominant one can get stuck
+        for (size_t i = 0; i < count; i++) {
+            const int home = allNoRelatedHelpers[i].getGroupIndex();
+            if (slots[i] != home || home == stuckGroup) {
+                continue;
             }
-            selectGroupID = noRelatednessGroupsID[selectGroupIndex];
-            // translates the index to the ID of a group from the noRelatednessGroupsID vector
-
-            auto indexLastIndividual = allNoRelatedHelpers.size() - 1;
-
-            if (selectGroupID != allNoRelatedHelpers[indexLastIndividual].getGroupIndex() || timeout > 5000) {
-                noRelatednessGroupsID.erase(noRelatednessGroupsID.begin() +
-                                            selectGroupIndex);
-                //remove the group ID from the vector to not draw it again
-                groups[selectGroupID].addHelper(
-                        allNoRelatedHelpers[indexLastIndividual]);
-                //add the no related helper to the helper vector in a randomly selected group
-                allNoRelatedHelpers.pop_back(); //remove the no related helper from its vector
-            } else {
-                timeout++; //if not other group to put the helper than the original one, do it anyway
+            const size_t start = Random::bounded(random, static_cast<uint32_t>(count));
+            bool swapped = false;
+            for (size_t step = 0; step < count && !swapped; step++) {
+                const size_t j = (start + step) % count;
+                if (slots[j] != home && allNoRelatedHelpers[j].getGroupIndex() != home) {
+                    std::swap(slots[i], slots[j]);
+                    swapped = true;
+                }
+            }
+            if (!swapped) {
+                stuckGroup = home;
             }
         }
+
+        for (size_t i = 0; i < count; i++) {
+            //add the no related helper to the helper vector of the receiving group
+            groups[slots[i]].addHelper(allNoRelatedHelpers, i);
+        }
     }
 }
 
 
 void Population::immigrate() {
     // Shuffle the group indices. This is done to ensure that the immigration process does not favor any particular group due to their position in the groups vector.
-    std::vector<int> indices(groups.size());
+    std::pmr::vector<int> indices(groups.size(), scratch);
     std::iota(indices.begin(), indices.end(), 0); // Fill it with consecutive numbers
-    std::shuffle(indices.begin(), indices.end(), *parameters->getGenerator());
+    RandomEngine random = parameters->stream(generation, Parameters::NO_VALUE, RandomPhase::IMMIGRATION);
+    Random::shuffle(indices.begin(), indices.end(), random);
 
     // Loop through the groups in a random order
-    if (!floaters.empty()) {
+    if (floaterCount() > 0) {
+        floatersExpanded = false;
+        bool colonized = false;
         // checks if there are any floaters available for immigration.
         for (int i: indices) {
             Group &group = groups[i];
 
             // Check if the group is empty, if so, floaters are recolonizing the territory
-            if (!group.isBreederAlive() && group.getHelpers().empty() && group.getSubordinateBreeders().empty()) {
+            if (group.isEmpty()) {
                 groupColonization++;
             }
 
-            // Add new helpers to the group
-            auto newHelpers = group.getAcceptedFloaters(floaters);
-            //  gets a list of floaters that are accepted by the current group.
-            group.addHelpers(newHelpers);
+            // Move the floaters accepted by the group to its helpers
+            if (compressedFloaters) {
+                group.acceptFloaters(floaterCohorts);
+            } else {
+                group.acceptFloaters(floaters);
+            }
+
+            if (!isActive[i]) {
+                if (group.isEmpty()) {
+                    group.settleExtinction();
+                } else {
+                    isActive[i] = true;
+                    colonized = true;
+                }
+            }
+        }
+
+        if (colonized) {
+            activeGroups.clear();
+            for (size_t i = 0; i < groups.size(); i++) {
+                if (isActive[i]) {
+                    activeGroups.push_back(static_cast<int>(i));
+                }
+            }
         }
     }
 }
 
 
 void Population::help() {
-    for (Group &group: groups) {
+    for (int i: activeGroups) {
         //Calculate help & cumulative help for group
-        group.calculateCumulativeHelp();
+        groups[i].calculateCumulativeHelp();
     }
 }
 
 void Population::survivalGroup() {
-    for (Group &group: groups) {
-        group.survivalGroup();
+    for (int i: activeGroups) {
+        groups[i].survivalGroup();
     }
 }
 
 
 void Population::survivalFloaters() {
-    for (Individual &floater: floaters) {
-        floater.calcSurvival(0, 0, false);
+    if (compressedFloaters) {
+        kernels->survival(parameters->getVitalRates(), floaterCohorts.getRepresentatives(), 0, false);
+        floatersExpanded = false;
+    } else {
+        kernels->survival(parameters->getVitalRates(), floaters, 0, false);
     }
 }
 
 void Population::mortalityGroup() {
-    for (Group &group: groups) {
+    for (int i: activeGroups) {
+        groups[i].mortalityGroup(deaths);
+    }
+    this->removeExtinctGroups();
+}
+
+void Population::helpSurvivalMortality() {
+    for (int i: activeGroups) {
+        Group &group = groups[i];
+        group.calculateCumulativeHelp();
+        group.survivalGroup();
         group.mortalityGroup(deaths);
     }
+    this->removeExtinctGroups();
 }
 
-void Population::mortalityFloaters() {
-    auto floaterIt = floaters.begin();
-    int size = floaters.size();
-    for (int count = 0; !floaters.empty() && size > count; count++) {
-        //Mortality floaters
-        if (parameters->uniform(*parameters->getGenerator()) > floaterIt->getSurvival()) {
-            *floaterIt = floaters[floaters.size() - 1];
-            floaters.pop_back();
-            deaths++;
+void Population::removeExtinctGroups() {
+    size_t kept = 0;
+    for (size_t j = 0; j < activeGroups.size(); j++) {
+        const int i = activeGroups[j];
+        if (groups[i].isEmpty()) {
+            groups[i].settleExtinction();
+            isActive[i] = false;
         } else {
-            floaterIt++;
+            activeGroups[kept++] = i;
         }
     }
+    activeGroups.resize(kept);
+}
+
+void Population::mortalityFloaters() {
+    UniformBuffer uniforms(parameters->stream(generation, Parameters::NO_VALUE, RandomPhase::FLOATER_MORTALITY));
+    if (compressedFloaters) {
+        deaths += static_cast<int>(floaterCohorts.mortality(uniforms.getEngine()));
+        floatersExpanded = false;
+    } else if (Config::IS_BINOMIAL_MORTALITY()) {
+        // All floaters have the same survival, so only the floaters that die are drawn
+        const Trait survival = static_cast<Trait>(parameters->getVitalRates().getFloaterSurvival());
+        deaths += static_cast<int>(floaters.binomialFilter(uniforms.getEngine(), 1.0 - survival, nullptr));
+    } else {
+        deaths += static_cast<int>(floaters.bernoulliFilter(
+                uniforms, floaters.survivals(),
+                IndividualStore::Removal::IF_ABOVE, nullptr, scratch));
+    }
 }
 
 void Population::reassignBreeder() {
-    for (Group &group: groups) {
-        group.reassignBreeders(newBreederOutsider, newBreederInsider, inheritance);
+    for (int i: activeGroups) {
+        groups[i].reassignBreeders(newBreederOutsider, newBreederInsider, inheritance);
     }
 }
 
+/**
+ * @brief Lays out the members of all groups contiguously, group by group, in every trait column.
+ *
+ * Called once per generation after the last change of group membership, so that the help, survival, statistics and
+ * mortality passes stream through memory. Each compaction alternates between two arenas: the one written now held
+ * the layout of two generations ago, which every store has since been copied out of.
+ */
+void Population::compactGroups() {
+    if (!Config::IS_COMPACT_GROUP_LAYOUT()) {
+        return;
+    }
+    currentLayout = 1 - currentLayout;
+    Arena &layout = layouts[currentLayout];
+    layout.reset();
+    IndividualStore::relocate(memberStores, &layout);
+}
+
 void Population::increaseAge() {
-    for (Group &group: groups) {
-        group.increaseAge();
+    for (int i: activeGroups) {
+        groups[i].increaseAge();
     }
     this->increaseAgeFloaters();
 }
 
 void Population::increaseAgeFloaters() {
-    for (Individual &floater: floaters) {
-        floater.increaseAge();
+    if (compressedFloaters) {
+        floaterCohorts.increaseAge();
+        floatersExpanded = false;
+        return;
+    }
+    int *ages = floaters.ages();
+    for (size_t i = 0; i < floaters.size(); i++) {
+        ages[i]++;
     }
 }
 
 double Population::getOffspringSurvival() {
-    auto rng = *parameters->getGenerator();
-    std::normal_distribution<double> NormalDist(0, parameters->getMMagnit());
+    RandomEngine rng = parameters->stream(generation, Parameters::NO_VALUE, RandomPhase::ENVIRONMENT);
 
 
     double offspringSurvival = parameters->getMOff();
@@ -197,7 +322,7 @@ double Population::getOffspringSurvival() {
         conditionCheckCounter++;
         int interval = static_cast<int>(1.0 / parameters->getMFreq());
         if (changeCounter < (conditionCheckCounter / interval)) {
-            double modification = abs(NormalDist(rng));
+            double modification = abs(Random::normal(rng, 0, parameters->getMMagnit()));
             if (negativeModification) {
                 modification = -modification;
             }
@@ -208,8 +333,8 @@ double Population::getOffspringSurvival() {
 
 
         //unpredictable environment
-    } else if (parameters->uniform(rng) < parameters->getMFreq()) {
-        offspringSurvival += NormalDist(rng);
+    } else if (Random::uniform(rng) < parameters->getMFreq()) {
+        offspringSurvival += Random::normal(rng, 0, parameters->getMMagnit());
     }
 
     if (offspringSurvival < 0) {
@@ -221,8 +346,9 @@ double Population::getOffspringSurvival() {
 
 void Population::reproduce(int generation) {
     this->mk = getOffspringSurvival();
-    for (Group &group: groups) {
-        group.reproduce(generation, mk);
+    mutation.setMutationAlpha(kernels->mutationAlpha(*parameters, generation));
+    for (int i: activeGroups) {
+        groups[i].reproduce(generation, mk, mutation);
     }
 }
 
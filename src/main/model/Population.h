@@ -2,9 +2,13 @@
 #define GROUP_AUGMENTATION_DATAMODEL_H
 
 #include <memory>
-#include "container/IndividualVector.h"
+#include <memory_resource>
+#include "container/IndividualStore.h"
+#include "container/FloaterCohorts.h"
 #include "Individual.h"
 #include "Group.h"
+#include "MutationEngine.h"
+#include "../util/Arena.h"
 
 
 /**
@@ -18,9 +22,30 @@ class Population {
 
     std::shared_ptr<Parameters> parameters;
 
+    std::pmr::memory_resource *scratch; ///< Allocator for containers that only live during the current generation.
+
+    const ScenarioKernels *kernels; ///< Formulas specialized for the scenario flags of the parameters.
+
     std::vector<Group> groups; ///< A vector of Group objects.
 
-    IndividualVector floaters; ///< A vector of Individual objects that are not part of any group.
+    // Groups that may have members, in increasing index order; the phases that do nothing for an empty group only
+    // visit these. Extinct groups leave at the end of mortality and colonized groups join in immigrate().
+    std::vector<int> activeGroups;
+    std::vector<char> isActive; ///< Per group, whether it is in activeGroups.
+
+    // Group members are periodically copied into one of two arenas, see compactGroups()
+    Arena layouts[2];
+    int currentLayout = 0;
+    std::vector<IndividualStore *> memberStores; ///< Helpers and subordinate breeders of every group, in group order.
+
+    MutationEngine mutation; ///< Mutates the offspring of all groups, see reproduce().
+
+    // The individuals that are not part of any group, one row each, or in cohorts of copies with COMPRESSED_FLOATERS.
+    // With cohorts, floaters is only an expanded copy for getFloaters().
+    bool compressedFloaters;
+    FloaterCohorts floaterCohorts;
+    mutable IndividualStore floaters;
+    mutable bool floatersExpanded = false;
 
     int deaths, groupColonization; ///< The number of deaths in the population.
 
@@ -30,6 +55,8 @@ class Population {
 
     double mk; ///< variable environmental mortality of offspring.
 
+    int generation = 0; ///< Current generation, selects the random streams.
+
     // variables to change the predictability of the environment
     int conditionCheckCounter = 0;
     int changeCounter = 0;
@@ -39,11 +66,20 @@ class Population {
 
     void increaseAgeFloaters();
 
+    size_t floaterCount() const;
+
+    void removeExtinctGroups();
+
 
 public:
-    explicit Population(const std::shared_ptr<Parameters>& parameters);
+    explicit Population(const std::shared_ptr<Parameters> &parameters,
+                        std::pmr::memory_resource *scratch = std::pmr::get_default_resource());
 
-    void reset();
+    /**
+     * @brief Starts a new generation: clears the counters and moves every group to the random streams of
+     * @p generation.
+     */
+    void reset(int generation);
 
     void disperse();
 
@@ -57,10 +93,18 @@ public:
 
     void mortalityGroup();
 
+    /**
+     * @brief help(), survivalGroup() and mortalityGroup() in one traversal, each group going through the three
+     * steps while its members are in cache. Leaves the same state, since groups draw from their own streams.
+     */
+    void helpSurvivalMortality();
+
     void mortalityFloaters();
 
     void reassignBreeder();
 
+    void compactGroups();
+
     void increaseAge();
 
     void reproduce(int generation);
@@ -70,7 +114,9 @@ public:
 
     const std::vector<Group> &getGroups() const;
 
-    const IndividualVector &getFloaters() const;
+    const std::vector<int> &getActiveGroups() const;
+
+    const IndividualStore &getFloaters() const;
 
     int getDeaths() const;
 
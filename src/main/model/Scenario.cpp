@@ -0,0 +1,153 @@
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <type_traits>
+#include "Scenario.h"
+#include "Individual.h"
+
+namespace {
+
+    void survival(const VitalRates &rates, IndividualStore &individuals, int groupSize, bool hasPotentialImmigrants) {
+        if (individuals.empty()) {
+            return;
+        }
+        // Floaters are kept apart; the members of a group are mostly helpers, so the whole store goes through the
+        // helper formula in one batch and the few subordinate breeders are recomputed afterwards
+        const RoleType *roles = individuals.roles();
+        if (roles[0] == FLOATER) {
+            assert(std::all_of(roles, roles + individuals.size(), [](RoleType other) { return other == FLOATER; }));
+            rates.survival(FLOATER, groupSize, individuals.helps(), individuals.gammas(), individuals.survivals(),
+                           individuals.size(), hasPotentialImmigrants);
+            return;
+        }
+        rates.survival(HELPER, groupSize, individuals.helps(), individuals.gammas(), individuals.survivals(),
+                       individuals.size(), hasPotentialImmigrants);
+        Trait *survivals = individuals.survivals();
+        for (size_t i = 0; i < individuals.size(); i++) {
+            if (roles[i] == BREEDER) {
+                survivals[i] = rates.survival(BREEDER, groupSize, individuals.helps()[i], individuals.gammas()[i], 0,
+                                              hasPotentialImmigrants);
+            }
+        }
+    }
+
+    template<class S>
+    double fecundity(const VitalRates &rates, double mk, double cumHelp, size_t subordinateBreeders) {
+        if constexpr (S::BET_HEDGING_HELP) {
+            if (mk > 1) { //TODO: Benign environment counted as 1 instead of mOff, change?
+                return mk * (rates.getK0() - rates.helpTerm(cumHelp) +
+                             rates.subordinateBreederTerm(subordinateBreeders));
+            }
+        }
+        if constexpr (S::HELP_OBLIGATORY) {
+            return mk * rates.getK0() + mk * rates.helpTerm(cumHelp) *
+                                        (1 + rates.subordinateBreederTerm(subordinateBreeders));
+        } else {
+            return mk * (rates.getK0() + rates.helpTerm(cumHelp) + rates.subordinateBreederTerm(subordinateBreeders));
+        }
+    }
+
+    template<class S>
+    double mutationAlpha(const Parameters &parameters, int generation) {
+        if constexpr (S::EVOLUTION_HELP_AFTER_DISPERSAL) {
+            if (generation < 25000) {
+                return 0;
+            }
+        }
+        return parameters.getMutationAlpha();
+    }
+
+    int countAgeOne(const IndividualStore &helpers) {
+        int count = 0;
+        const int *ages = helpers.ages();
+        for (size_t i = 0; i < helpers.size(); i++) {
+            count += ages[i] == 1;
+        }
+        return count;
+    }
+
+    template<class S>
+    int helpersToReassign(RandomEngine &random, const IndividualStore &helpers) {
+        if constexpr (S::RELATEDNESS == RelatednessMode::NO_RELATEDNESS) {
+            return countAgeOne(helpers);
+
+        } else if constexpr (S::RELATEDNESS == RelatednessMode::REDUCED_THIRD) {
+            return round(countAgeOne(helpers) / 3);
+
+        } else if constexpr (S::RELATEDNESS == RelatednessMode::REDUCED_HALF) {
+            double value = static_cast<double>(countAgeOne(helpers)) / 2;
+            if (value != floor(value)) { // Check if the value is not an integer
+                if (Random::uniform(random) < 0.5) {
+                    return floor(value);
+                } else {
+                    return ceil(value);
+                }
+            }
+            return value; // If the value is an integer, just assign it normally
+
+        } else {
+            return 0; // Any other value than 2 or 3 of reduced relatedness will not reassign helpers
+        }
+    }
+
+    template<class S>
+    const ScenarioKernels &kernelsFor() {
+        static const ScenarioKernels kernels{&survival, &fecundity<S>, &mutationAlpha<S>, &helpersToReassign<S>};
+        return kernels;
+    }
+
+    // Turns a runtime flag into a std::integral_constant, so that the callback can use it as a template argument
+    template<class F>
+    const ScenarioKernels &withFlag(bool flag, F &&f) {
+        if (flag) {
+            return f(std::true_type{});
+        } else {
+            return f(std::false_type{});
+        }
+    }
+
+    template<class F>
+    const ScenarioKernels &withRelatedness(RelatednessMode mode, F &&f) {
+        switch (mode) {
+            case RelatednessMode::NO_RELATEDNESS:
+                return f(std::integral_constant<RelatednessMode, RelatednessMode::NO_RELATEDNESS>{});
+            case RelatednessMode::REDUCED_HALF:
+                return f(std::integral_constant<RelatednessMode, RelatednessMode::REDUCED_HALF>{});
+            case RelatednessMode::REDUCED_THIRD:
+                return f(std::integral_constant<RelatednessMode, RelatednessMode::REDUCED_THIRD>{});
+            default:
+                return f(std::integral_constant<RelatednessMode, RelatednessMode::RELATED>{});
+        }
+    }
+
+    RelatednessMode relatednessMode(const Parameters &parameters) {
+        if (parameters.isNoRelatedness()) {
+            return RelatednessMode::NO_RELATEDNESS;
+        } else if (parameters.getReducedRelatedness() == 3) {
+            return RelatednessMode::REDUCED_THIRD;
+        } else if (parameters.getReducedRelatedness() == 2) {
+            return RelatednessMode::REDUCED_HALF;
+        } else {
+            return RelatednessMode::RELATED;
+        }
+    }
+}
+
+const ScenarioKernels &ScenarioKernels::select(const Parameters &parameters) {
+    using Kernels = const ScenarioKernels &;
+    return withFlag(parameters.isNoGroupAugmentation(), [&](auto noGroupAugmentation) -> Kernels {
+        return withFlag(parameters.isEvolutionHelpAfterDispersal(), [&](auto helpAfterDispersal) -> Kernels {
+            return withFlag(parameters.isBetHedgingHelp(), [&](auto betHedging) -> Kernels {
+                return withFlag(parameters.isHelpObligatory(), [&](auto helpObligatory) -> Kernels {
+                    return withRelatedness(relatednessMode(parameters), [&](auto relatedness) -> Kernels {
+                        return kernelsFor<Scenario<decltype(noGroupAugmentation)::value,
+                                decltype(helpAfterDispersal)::value,
+                                decltype(betHedging)::value,
+                                decltype(helpObligatory)::value,
+                                decltype(relatedness)::value>>();
+                    });
+                });
+            });
+        });
+    });
+}
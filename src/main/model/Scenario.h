@@ -0,0 +1,66 @@
+#ifndef GROUP_AUGMENTATION_SCENARIO_H
+#define GROUP_AUGMENTATION_SCENARIO_H
+
+#include "../util/Parameters.h"
+#include "container/IndividualStore.h"
+#include "RoleType.h"
+#include "VitalRates.h"
+
+/**
+ * How newborn helpers are moved between groups to reduce relatedness (NO_RELATEDNESS and REDUCED_RELATEDNESS).
+ */
+enum class RelatednessMode {
+    RELATED, ///< No helpers are reassigned.
+    NO_RELATEDNESS, ///< All helpers of age 1 are reassigned.
+    REDUCED_HALF, ///< Half of the helpers of age 1 are reassigned (REDUCED_RELATEDNESS: 2).
+    REDUCED_THIRD ///< A third of the helpers of age 1 are reassigned (REDUCED_RELATEDNESS: 3).
+};
+
+/**
+ * @brief The scenario flags of a parameter file as compile-time constants.
+ */
+template<bool NoGroupAugmentation, bool EvolutionHelpAfterDispersal, bool BetHedgingHelp, bool HelpObligatory,
+        RelatednessMode Relatedness>
+struct Scenario {
+    static constexpr bool NO_GROUP_AUGMENTATION = NoGroupAugmentation;
+    static constexpr bool EVOLUTION_HELP_AFTER_DISPERSAL = EvolutionHelpAfterDispersal;
+    static constexpr bool BET_HEDGING_HELP = BetHedgingHelp;
+    static constexpr bool HELP_OBLIGATORY = HelpObligatory;
+    static constexpr RelatednessMode RELATEDNESS = Relatedness;
+};
+
+/**
+ * @struct ScenarioKernels
+ * @brief The parts of a generation that depend on the scenario flags, compiled once per flag combination.
+ *
+ * select() reads the flags of a Parameters object once and returns the kernels instantiated for that combination, so
+ * the loops over individuals and groups do not test any scenario flag.
+ */
+struct ScenarioKernels {
+
+    /**
+     * @brief Survival of every individual of a store: the members of one group, helpers and subordinate breeders
+     * mixed, or floaters.
+     */
+    void (*survival)(const VitalRates &rates, IndividualStore &individuals, int groupSize, bool hasPotentialImmigrants);
+
+    /**
+     * @brief Expected number of offspring of a group with at least one breeder, before the Poisson draw.
+     */
+    double (*fecundity)(const VitalRates &rates, double mk, double cumHelp, size_t subordinateBreeders);
+
+    /**
+     * @brief Mutation rate of alpha for the offspring born in the given generation.
+     */
+    double (*mutationAlpha)(const Parameters &parameters, int generation);
+
+    /**
+     * @brief Number of newborn helpers a group gives up to reduce relatedness.
+     */
+    int (*helpersToReassign)(RandomEngine &random, const IndividualStore &helpers);
+
+    static const ScenarioKernels &select(const Parameters &parameters);
+};
+
+
+#endif //GROUP_AUGMENTATION_SCENARIO_H
@@ -0,0 +1,18 @@
+#ifndef GROUP_AUGMENTATION_TRAIT_H
+#define GROUP_AUGMENTATION_TRAIT_H
+
+/**
+ * Scalar type used to store genes and phenotypes.
+ *
+ * Defaults to double. Building with GENOME_FLOAT defined (target App_float) stores them in single precision, which
+ * halves the memory of the trait columns. Formulas are still evaluated in double precision.
+ */
+#ifdef GENOME_FLOAT
+using Trait = float;
+inline constexpr const char *TRAIT_FILE_SUFFIX = "_float"; ///< Keeps the outputs apart from those of the double build.
+#else
+using Trait = double;
+inline constexpr const char *TRAIT_FILE_SUFFIX = "";
+#endif
+
+#endif //GROUP_AUGMENTATION_TRAIT_H
@@ -0,0 +1,83 @@
+#include <cassert>
+#include <algorithm>
+#include "VitalRates.h"
+#include "../util/Config.h"
+#include "../util/FastMath.h"
+
+VitalRates::VitalRates(const Parameters &parameters) {
+    noGroupAugmentation = parameters.isNoGroupAugmentation();
+    fastSurvival = Config::IS_FAST_SURVIVAL();
+    fixedGroupSize = parameters.getFixedGroupSize();
+    K0 = parameters.getK0();
+    Kh = parameters.getKh();
+    Knb = parameters.getKnb();
+
+    X0 = parameters.getX0();           // min survival
+    X1 = 1 - X0 - parameters.getM(); //  X0 + X1 max survival
+    if (X1 < 0) { X1 = 0; }
+
+    double Xn = parameters.getXn(), Xe = parameters.getXe(), Xh = parameters.getXh(), Xrs = parameters.getXrs();
+    coefficients[BREEDER] = {Xn * X1, Xe * X1, 0, Xrs * X1, Xn + Xe + 0 + Xrs};
+    coefficients[HELPER] = {Xn * X1, Xe * X1, Xh * X1, 0, Xn + Xe + Xh + 0};
+    for (RoleType role: {BREEDER, HELPER}) {
+        expulsionWithoutImmigrants[role] = coefficients[role].Xe / (1 + exp(0.0));
+        suppressionWithoutDelta[role] = coefficients[role].Xrs / (1 + exp(0.0));
+    }
+
+    // effect of environment (X1) + exp(0) + additional survival/mortality defined by Xf
+    floaterSurvival = clampSurvival(X0 + (X1 / 2) + parameters.getXf());
+
+    groupSizeTerms.resize(TABLE_SIZE);
+    subordinateBreederTerms.resize(TABLE_SIZE);
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        double size = noGroupAugmentation ? fixedGroupSize : static_cast<double>(i);
+        groupSizeTerms[i] = coefficients[HELPER].Xn / (1 + exp(-size));
+        subordinateBreederTerms[i] = Knb * i / (1 + i);
+    }
+}
+
+double VitalRates::clampSurvival(double survival) {
+    assert(survival >= 0 && survival <= 1);
+    if (survival > 0.95) { survival = 0.95; }
+    else if (survival < 0) { survival = 0; } //prevent survival to be close to 1 or negative
+    return survival;
+}
+
+void VitalRates::survival(RoleType roleType, int groupSize, const Trait *helps, const Trait *gammas,
+                          Trait *survivals, size_t count, bool hasPotentialImmigrants) const {
+    if (fastSurvival) {
+        survival([](double x) { return fastExp(x); }, roleType, groupSize, helps, gammas, survivals, count,
+                 hasPotentialImmigrants);
+    } else {
+        survival([](double x) { return std::exp(x); }, roleType, groupSize, helps, gammas, survivals, count,
+                 hasPotentialImmigrants);
+    }
+}
+
+template<class Exp>
+void VitalRates::survival(Exp exp, RoleType roleType, int groupSize, const Trait *helps, const Trait *gammas,
+                          Trait *survivals, size_t count, bool hasPotentialImmigrants) const {
+    if (roleType == FLOATER) {
+        std::fill(survivals, survivals + count, floaterSurvival);
+        return;
+    }
+    const RoleCoefficients &role = coefficients[roleType];
+    if (role.sum == 0) {
+        std::fill(survivals, survivals + count, clampSurvival(X0));
+        return;
+    }
+
+    // Everything but the help and gamma terms is the same for the whole batch
+    const double base = X0, Xh = role.Xh, Xe = role.Xe, sum = role.sum;
+    const double sizeTerm = role.Xn == 0 ? 0 : groupSizeTerm(groupSize);
+    const double suppressionTerm = suppressionWithoutDelta[roleType];
+    const double fixedExpulsionTerm = expulsionWithoutImmigrants[roleType];
+    const bool hasHelpTerm = Xh != 0;
+    const bool hasExpulsionTerm = Xe != 0 && hasPotentialImmigrants;
+
+    for (size_t i = 0; i < count; i++) {
+        double helpTerm = hasHelpTerm ? Xh / (1 + exp(helps[i])) : 0;
+        double expulsionTerm = hasExpulsionTerm ? Xe / (1 + exp(gammas[i])) : fixedExpulsionTerm;
+        survivals[i] = clampSurvival(base + (sizeTerm + helpTerm + expulsionTerm + suppressionTerm) / sum);
+    }
+}
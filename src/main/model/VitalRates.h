@@ -0,0 +1,123 @@
+#ifndef GROUP_AUGMENTATION_VITALRATES_H
+#define GROUP_AUGMENTATION_VITALRATES_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "../util/Parameters.h"
+#include "RoleType.h"
+#include "Trait.h"
+
+/**
+ * @class VitalRates
+ * @brief Survival and fecundity formulas with every parameter-only part evaluated once per Parameters.
+ *
+ * The survival coefficients of each role are stored already multiplied by X1, the group size term and the
+ * subordinate breeder term of the fecundity are tabulated for integer arguments, and the survival of floaters, which
+ * only depends on the parameters, is a single constant. Terms whose coefficient is 0 are skipped instead of calling
+ * exp(). All values are computed with the same operations as Individual::computeSurvival, so they are bit-identical.
+ */
+class VitalRates {
+
+    struct RoleCoefficients {
+        double Xn, Xe, Xh, Xrs; ///< Survival coefficients of the role, multiplied by X1.
+        double sum; ///< Xn + Xe + Xh + Xrs of the role, before the multiplication.
+    };
+
+    static constexpr size_t TABLE_SIZE = 128; ///< Group sizes and subordinate breeder counts that are tabulated.
+
+    bool noGroupAugmentation;
+    bool fastSurvival;
+    double X0, X1, K0, Kh, Knb;
+    double fixedGroupSize;
+    double floaterSurvival;
+    std::array<RoleCoefficients, 2> coefficients; ///< Indexed by BREEDER and HELPER.
+    std::array<double, 2> expulsionWithoutImmigrants; ///< Xe * X1 / (1 + exp(0)) per role.
+    std::array<double, 2> suppressionWithoutDelta; ///< Xrs * X1 / (1 + exp(0)) per role.
+    std::vector<double> groupSizeTerms; ///< Xn * X1 / (1 + exp(-groupSize)) of helpers and breeders.
+    std::vector<double> subordinateBreederTerms; ///< Knb * n / (1 + n).
+
+    [[nodiscard]] double groupSizeTerm(int groupSize) const {
+        if (static_cast<size_t>(groupSize) < TABLE_SIZE) {
+            return groupSizeTerms[groupSize];
+        }
+        double size = noGroupAugmentation ? fixedGroupSize : groupSize;
+        return coefficients[HELPER].Xn / (1 + exp(-size));
+    }
+
+    static double clampSurvival(double survival);
+
+    template<class Exp>
+    void survival(Exp exp, RoleType roleType, int groupSize, const Trait *helps, const Trait *gammas,
+                  Trait *survivals, size_t count, bool hasPotentialImmigrants) const;
+
+public:
+
+    explicit VitalRates(const Parameters &parameters);
+
+    /**
+     * @brief Survival of a breeder or helper, same as Individual::computeSurvival.
+     *
+     * @param delta Reproductive concession of a breeder; pass 0 for subordinate breeders.
+     */
+    [[nodiscard]] double survival(RoleType roleType, int groupSize, double help, double gamma, double delta,
+                                  bool hasPotentialImmigrants) const {
+        if (roleType == FLOATER) {
+            return floaterSurvival;
+        }
+        const RoleCoefficients &role = coefficients[roleType];
+        if (role.sum == 0) {
+            return clampSurvival(X0);
+        }
+        double sizeTerm = role.Xn == 0 ? 0 : groupSizeTerm(groupSize);
+        double helpTerm = role.Xh == 0 ? 0 : role.Xh / (1 + exp(help));
+        double expulsionTerm = role.Xe == 0 || !hasPotentialImmigrants ? expulsionWithoutImmigrants[roleType]
+                                                                       : role.Xe / (1 + exp(gamma));
+        double suppressionTerm = role.Xrs == 0 || delta == 0 ? suppressionWithoutDelta[roleType]
+                                                             : role.Xrs / (1 + exp(delta));
+        return clampSurvival(X0 + (sizeTerm + helpTerm + expulsionTerm + suppressionTerm) / role.sum);
+    }
+
+    /**
+     * @brief Survival of @p count individuals of the same role, with delta 0, from contiguous help and gamma columns.
+     *
+     * With Config::FAST_SURVIVAL the exponentials use fastExp() and the loop vectorizes; otherwise every value is
+     * bit-identical to the single-individual overload.
+     */
+    void survival(RoleType roleType, int groupSize, const Trait *helps, const Trait *gammas, Trait *survivals,
+                  size_t count, bool hasPotentialImmigrants) const;
+
+    [[nodiscard]] double getFloaterSurvival() const { return floaterSurvival; }
+
+    /**
+     * @brief Whether all the individuals of a role in one group (or all floaters) get the same survival, i.e. the
+     * terms in help and gamma are constant.
+     */
+    [[nodiscard]] bool isUniformSurvival(RoleType roleType, bool hasPotentialImmigrants) const {
+        if (roleType == FLOATER) {
+            return true;
+        }
+        const RoleCoefficients &role = coefficients[roleType];
+        return role.sum == 0 || (role.Xh == 0 && (role.Xe == 0 || !hasPotentialImmigrants));
+    }
+
+    [[nodiscard]] double getK0() const { return K0; }
+
+    /**
+     * @brief Kh * cumHelp / (1 + cumHelp), the benefit of help in the fecundity.
+     */
+    [[nodiscard]] double helpTerm(double cumHelp) const { return Kh * cumHelp / (1 + cumHelp); }
+
+    /**
+     * @brief Knb * n / (1 + n), the effect of the number of subordinate breeders in the fecundity.
+     */
+    [[nodiscard]] double subordinateBreederTerm(size_t subordinateBreeders) const {
+        if (subordinateBreeders < TABLE_SIZE) {
+            return subordinateBreederTerms[subordinateBreeders];
+        }
+        return Knb * subordinateBreeders / (1 + subordinateBreeders);
+    }
+};
+
+
+#endif //GROUP_AUGMENTATION_VITALRATES_H
@@ -9,9 +9,9 @@
 template<class T>
 
 class Container {
-    explicit Container(std::default_random_engine *generator);
+    explicit Container(RandomEngine *generator);
 
-    std::default_random_engine generator;
+    RandomEngine generator;
 
 protected:
     std::vector<T> vector;
@@ -19,6 +19,7 @@ protected:
 
 public:
 
+    Container() = default;
 
     [[nodiscard]] unsigned int size() const;
 
@@ -92,8 +93,7 @@ void Container<T>::merge(const Container<T> &container) {
 
 template<class T>
 T Container<T>::getRandomElement() const {
-    std::uniform_int_distribution<int> uniform(0, vector.size() - 1);
-    int index = uniform(generator); // selects a random index the noRelatednessGroupsID vector
+    int index = Random::uniformInt(generator, 0, vector.size() - 1); // selects a random index the noRelatednessGroupsID vector
     return this->vector[index];
 }
 
@@ -123,7 +123,7 @@ void Container<T>::removeLast() {
 }
 
 template<class T>
-Container<T>::Container(std::default_random_engine *generator): generator(*generator) {}
+Container<T>::Container(RandomEngine *generator): generator(*generator) {}
 
 template<class T>
 void Container<T>::shuffle() {
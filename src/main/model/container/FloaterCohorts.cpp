@@ -0,0 +1,122 @@
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+#include "FloaterCohorts.h"
+
+namespace {
+    // What makes two floaters copies of each other
+    struct CohortKey {
+        Trait alpha, beta, gamma, delta, drift;
+        int age, ageBecomeBreeder;
+        bool inherit;
+
+        explicit CohortKey(IndividualStore::ConstRef floater) :
+                alpha(floater.getAlpha()), beta(floater.getBeta()), gamma(floater.getGamma()),
+                delta(floater.getDelta()), drift(floater.getDrift()), age(floater.getAge()),
+                ageBecomeBreeder(floater.getAgeBecomeBreeder()), inherit(floater.isInherit()) {}
+
+        bool operator==(const CohortKey &other) const {
+            return alpha == other.alpha && beta == other.beta && gamma == other.gamma && delta == other.delta &&
+                   drift == other.drift && age == other.age && ageBecomeBreeder == other.ageBecomeBreeder &&
+                   inherit == other.inherit;
+        }
+    };
+
+    struct CohortKeyHash {
+        size_t operator()(const CohortKey &key) const {
+            size_t hash = std::hash<int>()(key.age) ^ std::hash<int>()(key.ageBecomeBreeder) << 1 ^ key.inherit;
+            for (Trait gene: {key.alpha, key.beta, key.gamma, key.delta, key.drift}) {
+                hash = hash * 31 + std::hash<Trait>()(gene);
+            }
+            return hash;
+        }
+    };
+}
+
+void FloaterCohorts::add(const IndividualStore &newFloaters, std::pmr::memory_resource *scratch) {
+    if (newFloaters.empty()) {
+        return;
+    }
+    std::pmr::unordered_map<CohortKey, size_t, CohortKeyHash> index(scratch);
+    index.reserve(representatives.size() + newFloaters.size());
+    for (size_t i = 0; i < representatives.size(); i++) {
+        index.emplace(CohortKey(representatives[i]), i);
+    }
+    for (size_t i = 0; i < newFloaters.size(); i++) {
+        auto [cohort, inserted] = index.emplace(CohortKey(newFloaters[i]), representatives.size());
+        if (inserted) {
+            representatives.push_back(newFloaters, i);
+            counts.push_back(1);
+        } else {
+            counts[cohort->second]++;
+        }
+    }
+    floaters += newFloaters.size();
+    sampler.reset();
+}
+
+size_t FloaterCohorts::mortality(RandomEngine &generator) {
+    const Trait *survivals = representatives.survivals();
+    size_t deaths = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        const int dead = Random::binomial(generator, counts[i], 1.0 - survivals[i]);
+        counts[i] -= dead;
+        deaths += dead;
+    }
+    floaters -= deaths;
+    removeEmptyCohorts();
+    return deaths;
+}
+
+void FloaterCohorts::take(RandomEngine &generator, size_t count, IndividualStore &taken, int firstId) {
+    assert(count <= floaters);
+    if (count == 0) {
+        return;
+    }
+    if (!sampler) {
+        sampler.emplace(counts.size(), [this](size_t i) { return counts[i]; }, std::pmr::get_default_resource());
+    }
+    taken.reserve(taken.size() + count);
+    for (size_t i = 0; i < count; i++) {
+        const size_t cohort = sampler->find(Random::bounded(generator, static_cast<uint32_t>(sampler->total())));
+        sampler->add(cohort, -1);
+        counts[cohort]--;
+        taken.push_back(representatives, cohort);
+        taken.back().setId(firstId + static_cast<int>(i));
+    }
+    floaters -= count;
+    // Emptied cohorts stay until the next bulk change, so that the sampler stays valid
+}
+
+void FloaterCohorts::increaseAge() {
+    int *ages = representatives.ages();
+    for (size_t i = 0; i < representatives.size(); i++) {
+        ages[i]++;
+    }
+}
+
+void FloaterCohorts::expand(IndividualStore &expanded) const {
+    expanded.clear();
+    expanded.reserve(floaters);
+    for (size_t i = 0; i < counts.size(); i++) {
+        for (int copy = 0; copy < counts[i]; copy++) {
+            expanded.push_back(representatives, i);
+        }
+    }
+}
+
+void FloaterCohorts::removeEmptyCohorts() {
+    std::vector<char> keep(counts.size());
+    size_t kept = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        keep[i] = counts[i] > 0;
+        if (keep[i]) {
+            counts[kept++] = counts[i];
+        }
+    }
+    if (kept != counts.size()) {
+        representatives.compact(keep.data(), nullptr);
+        counts.resize(kept);
+    }
+    sampler.reset();
+}
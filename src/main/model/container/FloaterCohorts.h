@@ -0,0 +1,75 @@
+#ifndef GROUP_AUGMENTATION_FLOATERCOHORTS_H
+#define GROUP_AUGMENTATION_FLOATERCOHORTS_H
+
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "IndividualStore.h"
+#include "../../util/FenwickTree.h"
+
+/**
+ * @class FloaterCohorts
+ * @brief The floaters of a population, with the floaters that are copies of each other stored once with a count.
+ *
+ * Until they immigrate, only the genes, age, age of becoming breeder and inherit flag of a floater matter, so
+ * floaters that agree on those behave the same. With low mutation rates most floaters are such clonal copies. Each
+ * cohort is one row of a store (its representative) and a count: survival and ageing work on the representatives,
+ * mortality draws one binomial per cohort, and individuals are only materialized when they are taken out to join a
+ * group. A cohort keeps the group index and id of the first floater that formed it.
+ */
+class FloaterCohorts {
+
+    IndividualStore representatives;
+    std::vector<int> counts;
+    size_t floaters = 0;
+    std::optional<FenwickTree> sampler; ///< The counts, built by the first take() after they change in bulk.
+
+    void removeEmptyCohorts();
+
+public:
+
+    /**
+     * @brief Number of floaters, not of cohorts.
+     */
+    [[nodiscard]] size_t size() const { return floaters; }
+
+    [[nodiscard]] bool empty() const { return floaters == 0; }
+
+    [[nodiscard]] size_t cohorts() const { return counts.size(); }
+
+    [[nodiscard]] int getCount(size_t cohort) const { return counts[cohort]; }
+
+    IndividualStore &getRepresentatives() { return representatives; }
+
+    [[nodiscard]] const IndividualStore &getRepresentatives() const { return representatives; }
+
+    /**
+     * @brief Adds new floaters, each to the cohort of its copies if there is one. The lookup table lives on
+     * @p scratch.
+     */
+    void add(const IndividualStore &newFloaters, std::pmr::memory_resource *scratch);
+
+    /**
+     * @brief Every floater dies with probability 1 - the survival of its cohort's representative; one binomial draw
+     * per cohort.
+     *
+     * @return The number of deaths.
+     */
+    size_t mortality(RandomEngine &generator);
+
+    /**
+     * @brief Takes @p count floaters uniformly at random without replacement and appends them to @p taken, with the
+     * ids firstId, firstId + 1, ...
+     */
+    void take(RandomEngine &generator, size_t count, IndividualStore &taken, int firstId);
+
+    void increaseAge();
+
+    /**
+     * @brief Writes every floater to @p expanded as its own row, for statistics and output.
+     */
+    void expand(IndividualStore &expanded) const;
+};
+
+
+#endif //GROUP_AUGMENTATION_FLOATERCOHORTS_H
@@ -0,0 +1,480 @@
+#include <cassert>
+#include <memory>
+#include <utility>
+#include "IndividualStore.h"
+
+namespace {
+    // pmr containers never change allocator on assignment, so the column is rebuilt in place on the new resource
+    template<class Store, class T>
+    void relocateColumn(const std::vector<Store *> &stores, std::pmr::vector<T> Store::*column,
+                        std::pmr::memory_resource *resource) {
+        for (Store *store: stores) {
+            std::pmr::vector<T> &values = store->*column;
+            std::pmr::vector<T> relocated(values.begin(), values.end(), resource);
+            std::destroy_at(&values);
+            ::new(static_cast<void *>(&values)) std::pmr::vector<T>(std::move(relocated));
+        }
+    }
+
+    // Stable in-place compaction of one column; the removed values are written with a one element slack at the end
+    template<class T>
+    void compactColumn(std::pmr::vector<T> &column, std::pmr::vector<T> *removedColumn, const char *keep) {
+        const size_t count = column.size();
+        size_t kept = 0;
+        if (removedColumn) {
+            size_t removed = removedColumn->size();
+            removedColumn->resize(removed + count + 1);
+            T *values = column.data(), *removedValues = removedColumn->data();
+            for (size_t i = 0; i < count; i++) {
+                T value = values[i];
+                values[kept] = value;
+                removedValues[removed] = value;
+                kept += keep[i];
+                removed += !keep[i];
+            }
+            removedColumn->resize(removed);
+        } else {
+            T *values = column.data();
+            for (size_t i = 0; i < count; i++) {
+                values[kept] = values[i];
+                kept += keep[i];
+            }
+        }
+        column.resize(kept);
+    }
+}
+
+template<class Scalar>
+BasicIndividualStore<Scalar>::BasicIndividualStore(std::pmr::memory_resource *resource) :
+        alpha(resource), beta(resource), gamma(resource), delta(resource), drift(resource),
+        help(resource), survival(resource), dispersal(resource),
+        age(resource), role(resource), ageBecomeBreeder(resource), inherit(resource), groupIndex(resource),
+        id(resource) {}
+
+template<class Scalar>
+size_t BasicIndividualStore<Scalar>::size() const {
+    return age.size();
+}
+
+template<class Scalar>
+bool BasicIndividualStore<Scalar>::empty() const {
+    return age.empty();
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::reserve(size_t capacity) {
+    alpha.reserve(capacity);
+    beta.reserve(capacity);
+    gamma.reserve(capacity);
+    delta.reserve(capacity);
+    drift.reserve(capacity);
+    help.reserve(capacity);
+    survival.reserve(capacity);
+    dispersal.reserve(capacity);
+    age.reserve(capacity);
+    role.reserve(capacity);
+    ageBecomeBreeder.reserve(capacity);
+    inherit.reserve(capacity);
+    groupIndex.reserve(capacity);
+    id.reserve(capacity);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::clear() {
+    alpha.clear();
+    beta.clear();
+    gamma.clear();
+    delta.clear();
+    drift.clear();
+    help.clear();
+    survival.clear();
+    dispersal.clear();
+    age.clear();
+    role.clear();
+    ageBecomeBreeder.clear();
+    inherit.clear();
+    groupIndex.clear();
+    id.clear();
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::push_back(const Individual &individual) {
+    alpha.push_back(individual.alpha);
+    beta.push_back(individual.beta);
+    gamma.push_back(individual.gamma);
+    delta.push_back(individual.delta);
+    drift.push_back(individual.drift);
+    help.push_back(individual.help);
+    survival.push_back(individual.survival);
+    dispersal.push_back(individual.dispersal);
+    age.push_back(individual.getAge());
+    role.push_back(individual.getRoleType());
+    ageBecomeBreeder.push_back(individual.ageBecomeBreeder);
+    inherit.push_back(individual.inherit);
+    groupIndex.push_back(individual.groupIndex);
+    id.push_back(individual.id);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::push_back(const BasicIndividualStore &other, size_t index) {
+    alpha.push_back(other.alpha[index]);
+    beta.push_back(other.beta[index]);
+    gamma.push_back(other.gamma[index]);
+    delta.push_back(other.delta[index]);
+    drift.push_back(other.drift[index]);
+    help.push_back(other.help[index]);
+    survival.push_back(other.survival[index]);
+    dispersal.push_back(other.dispersal[index]);
+    age.push_back(other.age[index]);
+    role.push_back(other.role[index]);
+    ageBecomeBreeder.push_back(other.ageBecomeBreeder[index]);
+    inherit.push_back(other.inherit[index]);
+    groupIndex.push_back(other.groupIndex[index]);
+    id.push_back(other.id[index]);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::merge(const BasicIndividualStore &other) {
+    alpha.insert(alpha.end(), other.alpha.begin(), other.alpha.end());
+    beta.insert(beta.end(), other.beta.begin(), other.beta.end());
+    gamma.insert(gamma.end(), other.gamma.begin(), other.gamma.end());
+    delta.insert(delta.end(), other.delta.begin(), other.delta.end());
+    drift.insert(drift.end(), other.drift.begin(), other.drift.end());
+    help.insert(help.end(), other.help.begin(), other.help.end());
+    survival.insert(survival.end(), other.survival.begin(), other.survival.end());
+    dispersal.insert(dispersal.end(), other.dispersal.begin(), other.dispersal.end());
+    age.insert(age.end(), other.age.begin(), other.age.end());
+    role.insert(role.end(), other.role.begin(), other.role.end());
+    ageBecomeBreeder.insert(ageBecomeBreeder.end(), other.ageBecomeBreeder.begin(), other.ageBecomeBreeder.end());
+    inherit.insert(inherit.end(), other.inherit.begin(), other.inherit.end());
+    groupIndex.insert(groupIndex.end(), other.groupIndex.begin(), other.groupIndex.end());
+    id.insert(id.end(), other.id.begin(), other.id.end());
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::pop_back() {
+    alpha.pop_back();
+    beta.pop_back();
+    gamma.pop_back();
+    delta.pop_back();
+    drift.pop_back();
+    help.pop_back();
+    survival.pop_back();
+    dispersal.pop_back();
+    age.pop_back();
+    role.pop_back();
+    ageBecomeBreeder.pop_back();
+    inherit.pop_back();
+    groupIndex.pop_back();
+    id.pop_back();
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::moveTail(size_t count, BasicIndividualStore &destination) {
+    assert(count <= size() && &destination != this);
+    const size_t first = size() - count;
+    auto move = [&](auto column) {
+        auto &values = this->*column;
+        auto &moved = destination.*column;
+        moved.insert(moved.end(), values.begin() + static_cast<long>(first), values.end());
+        values.resize(first);
+    };
+    move(&BasicIndividualStore::alpha);
+    move(&BasicIndividualStore::beta);
+    move(&BasicIndividualStore::gamma);
+    move(&BasicIndividualStore::delta);
+    move(&BasicIndividualStore::drift);
+    move(&BasicIndividualStore::help);
+    move(&BasicIndividualStore::survival);
+    move(&BasicIndividualStore::dispersal);
+    move(&BasicIndividualStore::age);
+    move(&BasicIndividualStore::role);
+    move(&BasicIndividualStore::ageBecomeBreeder);
+    move(&BasicIndividualStore::inherit);
+    move(&BasicIndividualStore::groupIndex);
+    move(&BasicIndividualStore::id);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::moveRow(size_t from, size_t to) {
+    alpha[to] = alpha[from];
+    beta[to] = beta[from];
+    gamma[to] = gamma[from];
+    delta[to] = delta[from];
+    drift[to] = drift[from];
+    help[to] = help[from];
+    survival[to] = survival[from];
+    dispersal[to] = dispersal[from];
+    age[to] = age[from];
+    role[to] = role[from];
+    ageBecomeBreeder[to] = ageBecomeBreeder[from];
+    inherit[to] = inherit[from];
+    groupIndex[to] = groupIndex[from];
+    id[to] = id[from];
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::appendNewbornState(int parentGroup, size_t count, RoleType roleType, int firstId) {
+    help.insert(help.end(), count, Scalar(0));
+    survival.insert(survival.end(), count, static_cast<Scalar>(Parameters::NO_VALUE));
+    dispersal.insert(dispersal.end(), count, static_cast<Scalar>(Parameters::NO_VALUE));
+    age.insert(age.end(), count, 1);
+    role.insert(role.end(), count, roleType);
+    ageBecomeBreeder.insert(ageBecomeBreeder.end(), count, static_cast<int>(Parameters::NO_VALUE));
+    inherit.insert(inherit.end(), count, true);
+    groupIndex.insert(groupIndex.end(), count, parentGroup);
+    for (size_t i = 0; i < count; i++) {
+        id.push_back(firstId + static_cast<int>(i));
+    }
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::appendOffspring(const BasicIndividualStore &parents, size_t parent, size_t count,
+                                                   RoleType roleType, int firstId) {
+    // Copied first, since the parents may be rows of this store
+    const Scalar parentAlpha = parents.alpha[parent], parentBeta = parents.beta[parent];
+    const Scalar parentGamma = parents.gamma[parent], parentDelta = parents.delta[parent];
+    const Scalar parentDrift = parents.drift[parent];
+    const int parentGroup = parents.groupIndex[parent];
+    alpha.insert(alpha.end(), count, parentAlpha);
+    beta.insert(beta.end(), count, parentBeta);
+    gamma.insert(gamma.end(), count, parentGamma);
+    delta.insert(delta.end(), count, parentDelta);
+    drift.insert(drift.end(), count, parentDrift);
+    appendNewbornState(parentGroup, count, roleType, firstId);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::appendOffspring(const Individual &parent, size_t count, RoleType roleType,
+                                                   int firstId) {
+    alpha.insert(alpha.end(), count, parent.alpha);
+    beta.insert(beta.end(), count, parent.beta);
+    gamma.insert(gamma.end(), count, parent.gamma);
+    delta.insert(delta.end(), count, parent.delta);
+    drift.insert(drift.end(), count, parent.drift);
+    appendNewbornState(parent.groupIndex, count, roleType, firstId);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::removeIndividual(size_t index) {
+    assert(index < size());
+    if (index != size() - 1) {
+        moveRow(size() - 1, index);
+    }
+    pop_back();
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::erase(size_t index) {
+    assert(index < size());
+    for (size_t i = index + 1; i < size(); i++) {
+        moveRow(i, i - 1);
+    }
+    pop_back();
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::swap(size_t first, size_t second) {
+    std::swap(alpha[first], alpha[second]);
+    std::swap(beta[first], beta[second]);
+    std::swap(gamma[first], gamma[second]);
+    std::swap(delta[first], delta[second]);
+    std::swap(drift[first], drift[second]);
+    std::swap(help[first], help[second]);
+    std::swap(survival[first], survival[second]);
+    std::swap(dispersal[first], dispersal[second]);
+    std::swap(age[first], age[second]);
+    std::swap(role[first], role[second]);
+    std::swap(ageBecomeBreeder[first], ageBecomeBreeder[second]);
+    std::swap(inherit[first], inherit[second]);
+    std::swap(groupIndex[first], groupIndex[second]);
+    std::swap(id[first], id[second]);
+}
+
+template<class Scalar>
+size_t BasicIndividualStore<Scalar>::binomialFilter(RandomEngine &generator, double probability,
+                                                    BasicIndividualStore *removed) {
+    const size_t count = size();
+    const auto drawn = static_cast<size_t>(Random::binomial(generator, static_cast<int>(count), probability));
+    const size_t first = count - drawn;
+    for (size_t i = count; i > first; i--) {
+        swap(i - 1, Random::bounded(generator, static_cast<uint32_t>(i)));
+    }
+    if (removed) {
+        moveTail(drawn, *removed);
+    } else {
+        for (size_t i = first; i < count; i++) {
+            pop_back();
+        }
+    }
+    return drawn;
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::compact(const char *keep, BasicIndividualStore *removed) {
+    auto compact = [&](auto column) {
+        compactColumn(this->*column, removed ? &(removed->*column) : nullptr, keep);
+    };
+    compact(&BasicIndividualStore::alpha);
+    compact(&BasicIndividualStore::beta);
+    compact(&BasicIndividualStore::gamma);
+    compact(&BasicIndividualStore::delta);
+    compact(&BasicIndividualStore::drift);
+    compact(&BasicIndividualStore::help);
+    compact(&BasicIndividualStore::survival);
+    compact(&BasicIndividualStore::dispersal);
+    compact(&BasicIndividualStore::age);
+    compact(&BasicIndividualStore::role);
+    compact(&BasicIndividualStore::ageBecomeBreeder);
+    compact(&BasicIndividualStore::inherit);
+    compact(&BasicIndividualStore::groupIndex);
+    compact(&BasicIndividualStore::id);
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::relocate(const std::vector<BasicIndividualStore *> &stores,
+                                            std::pmr::memory_resource *resource) {
+    relocateColumn(stores, &BasicIndividualStore::alpha, resource);
+    relocateColumn(stores, &BasicIndividualStore::beta, resource);
+    relocateColumn(stores, &BasicIndividualStore::gamma, resource);
+    relocateColumn(stores, &BasicIndividualStore::delta, resource);
+    relocateColumn(stores, &BasicIndividualStore::drift, resource);
+    relocateColumn(stores, &BasicIndividualStore::help, resource);
+    relocateColumn(stores, &BasicIndividualStore::survival, resource);
+    relocateColumn(stores, &BasicIndividualStore::dispersal, resource);
+    relocateColumn(stores, &BasicIndividualStore::age, resource);
+    relocateColumn(stores, &BasicIndividualStore::role, resource);
+    relocateColumn(stores, &BasicIndividualStore::ageBecomeBreeder, resource);
+    relocateColumn(stores, &BasicIndividualStore::inherit, resource);
+    relocateColumn(stores, &BasicIndividualStore::groupIndex, resource);
+    relocateColumn(stores, &BasicIndividualStore::id, resource);
+}
+
+template<class Scalar>
+Individual BasicIndividualStore<Scalar>::toIndividual(size_t index) const {
+    Individual individual;
+    individual.roleType = role[index];
+    individual.alpha = alpha[index];
+    individual.beta = beta[index];
+    individual.gamma = gamma[index];
+    individual.delta = delta[index];
+    individual.drift = drift[index];
+    individual.help = help[index];
+    individual.survival = survival[index];
+    individual.dispersal = dispersal[index];
+    individual.age = age[index];
+    individual.ageBecomeBreeder = ageBecomeBreeder[index];
+    individual.inherit = inherit[index];
+    individual.groupIndex = groupIndex[index];
+    individual.id = id[index];
+    return individual;
+}
+
+/**
+ * @brief Get the attribute values of the rows in the store.
+ *
+ * If the attribute type is DISPERSAL, only the attribute values of individuals with age 1 are returned.
+ * For other attribute types, the attribute values of all individuals are returned.
+ */
+template<class Scalar>
+std::vector<double> BasicIndividualStore<Scalar>::get(Attribute attribute) const {
+    std::vector<double> result;
+    result.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        if (attribute == Attribute::DISPERSAL && age[i] != 1) {
+            continue;
+        }
+        result.push_back((*this)[i].get(attribute));
+    }
+    return result;
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::Ref BasicIndividualStore<Scalar>::operator[](size_t index) {
+    return {this, index};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::ConstRef BasicIndividualStore<Scalar>::operator[](size_t index) const {
+    return {this, index};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::Ref BasicIndividualStore<Scalar>::back() {
+    return {this, size() - 1};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::ConstRef BasicIndividualStore<Scalar>::back() const {
+    return {this, size() - 1};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::iterator BasicIndividualStore<Scalar>::begin() {
+    return {this, 0};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::iterator BasicIndividualStore<Scalar>::end() {
+    return {this, size()};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::const_iterator BasicIndividualStore<Scalar>::begin() const {
+    return {this, 0};
+}
+
+template<class Scalar>
+typename BasicIndividualStore<Scalar>::const_iterator BasicIndividualStore<Scalar>::end() const {
+    return {this, size()};
+}
+
+
+template<class Scalar>
+double BasicIndividualStore<Scalar>::ConstRef::get(Attribute attribute) const {
+    switch (attribute) {
+        case ALPHA:
+            return getAlpha();
+        case BETA:
+            return getBeta();
+        case GAMMA:
+            return getGamma();
+        case DELTA:
+            return getDelta();
+        case HELP:
+            return getHelp();
+        case DISPERSAL:
+            return getDispersal();
+        case SURVIVAL:
+            return getSurvival();
+        case DRIFT:
+            return getDrift();
+        case AGE:
+            return getAge();
+        case AGE_BECOME_BREEDER:
+            return store->ageBecomeBreeder[index];
+        case FECUNDITY:
+            return Parameters::NO_VALUE; // individual fecundities are not tracked
+    }
+
+    assert(false);
+    return Parameters::NO_VALUE;
+}
+
+template<class Scalar>
+void BasicIndividualStore<Scalar>::Ref::setRoleType(RoleType type) const {
+    BasicIndividualStore *individuals = mutableStore();
+    individuals->role[this->index] = type;
+    if (type == BREEDER) {
+        individuals->dispersal[this->index] = Parameters::NO_VALUE;
+        individuals->help[this->index] = 0;
+    }
+    if (type == FLOATER) {
+        individuals->help[this->index] = 0;
+    }
+}
+
+
+template class BasicIndividualStore<float>;
+
+template class BasicIndividualStore<double>;
@@ -0,0 +1,366 @@
+#ifndef GROUP_AUGMENTATION_INDIVIDUALSTORE_H
+#define GROUP_AUGMENTATION_INDIVIDUALSTORE_H
+
+#include <memory_resource>
+#include <vector>
+#include "../../util/Random.h"
+#include "../Individual.h"
+#include "../Attribute.h"
+#include "../RoleType.h"
+#include "../Trait.h"
+
+/**
+ * @class BasicIndividualStore
+ * @brief Structure-of-arrays storage for a set of individuals, with genes and phenotypes stored as @p Scalar.
+ *
+ * Every trait is kept in its own contiguous column, so a phase that only needs one or two traits of every individual
+ * (help, survival, age, ...) streams through those columns instead of dragging whole Individual objects through cache.
+ * Rows are addressed by index; Ref and ConstRef give access to a single row with the same getters and setters as
+ * Individual, and toIndividual() materializes a row whenever a real Individual is needed.
+ *
+ * Columns allocate from a std::pmr memory resource, so stores that only live for one phase can be built on the
+ * generation Arena. Copies always go back to the default resource.
+ *
+ * The simulation uses the IndividualStore alias, whose scalar type is selected at compile time (see Trait.h).
+ */
+template<class Scalar>
+class BasicIndividualStore {
+
+    // Genes
+    std::pmr::vector<Scalar> alpha;
+    std::pmr::vector<Scalar> beta;
+    std::pmr::vector<Scalar> gamma;
+    std::pmr::vector<Scalar> delta;
+    std::pmr::vector<Scalar> drift;
+
+    // Phenotypes
+    std::pmr::vector<Scalar> help;
+    std::pmr::vector<Scalar> survival;
+    std::pmr::vector<Scalar> dispersal;
+
+    // State
+    std::pmr::vector<int> age;
+    std::pmr::vector<RoleType> role;
+    std::pmr::vector<int> ageBecomeBreeder;
+    std::pmr::vector<char> inherit;
+    std::pmr::vector<int> groupIndex;
+    std::pmr::vector<int> id;
+
+    void moveRow(size_t from, size_t to);
+
+    void appendNewbornState(int parentGroup, size_t count, RoleType roleType, int firstId);
+
+public:
+
+    class ConstRef;
+
+    class Ref;
+
+    template<class Reference, class Store>
+    class Iterator;
+
+    using iterator = Iterator<Ref, BasicIndividualStore>;
+    using const_iterator = Iterator<ConstRef, const BasicIndividualStore>;
+
+    BasicIndividualStore() = default;
+
+    explicit BasicIndividualStore(std::pmr::memory_resource *resource);
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool empty() const;
+
+    void reserve(size_t capacity);
+
+    void clear();
+
+    /**
+     * @brief Appends a copy of the individual as a new row.
+     */
+    void push_back(const Individual &individual);
+
+    /**
+     * @brief Appends row @p index of another store, column by column.
+     */
+    void push_back(const BasicIndividualStore &other, size_t index);
+
+    /**
+     * @brief Appends all rows of another store.
+     */
+    void merge(const BasicIndividualStore &other);
+
+    void pop_back();
+
+    /**
+     * @brief Moves the last @p count rows, in order, to the end of @p destination: one block copy per column, with no
+     * intermediate store.
+     */
+    void moveTail(size_t count, BasicIndividualStore &destination);
+
+    /**
+     * @brief Appends @p count newborns of the given role with the genome and group index of row @p parent of
+     * @p parents, and the ids firstId, firstId + 1, ...
+     *
+     * Same state as Individual's offspring constructor, written one column at a time; the genomes are mutated
+     * separately (see MutationEngine).
+     */
+    void appendOffspring(const BasicIndividualStore &parents, size_t parent, size_t count, RoleType roleType,
+                         int firstId);
+
+    /**
+     * @brief Appends @p count newborns of the given role with the genome and group index of @p parent.
+     */
+    void appendOffspring(const Individual &parent, size_t count, RoleType roleType, int firstId);
+
+    /**
+     * @brief Removes a row by moving the last row into its place.
+     *
+     * Same semantics as IndividualVector::removeIndividual: constant time, order of the remaining rows not preserved.
+     */
+    void removeIndividual(size_t index);
+
+    /**
+     * @brief Removes a row while preserving the order of the remaining rows.
+     */
+    void erase(size_t index);
+
+    void swap(size_t first, size_t second);
+
+    /**
+     * @brief Keeps the rows whose @p keep flag is set, in their current order, and appends the others to @p removed.
+     *
+     * Each column is compacted in one branch-free pass. @p removed may be null when the rows are simply dropped.
+     */
+    void compact(const char *keep, BasicIndividualStore *removed);
+
+    /**
+     * @brief Which rows a Bernoulli filter removes: the ones whose uniform draw is below or above their probability.
+     */
+    enum class Removal { IF_BELOW, IF_ABOVE };
+
+    /**
+     * @brief One Bernoulli trial per row, shared by dispersal and mortality.
+     *
+     * A block of uniforms is drawn first (one per row, in row order), compared with @p probabilities in a separate
+     * loop, and the store is then compacted with the resulting mask; see compact(). The draws and the mask live on
+     * @p scratch.
+     *
+     * @return The number of removed rows.
+     */
+    template<class Draw>
+    size_t bernoulliFilter(Draw &&draw, const Scalar *probabilities, Removal removal, BasicIndividualStore *removed,
+                           std::pmr::memory_resource *scratch) {
+        const size_t count = size();
+        std::pmr::vector<double> uniforms(count, scratch);
+        for (double &uniform: uniforms) {
+            uniform = draw();
+        }
+        std::pmr::vector<char> keep(count, scratch);
+        size_t kept = 0;
+        if (removal == Removal::IF_BELOW) {
+            for (size_t i = 0; i < count; i++) {
+                keep[i] = !(uniforms[i] < probabilities[i]);
+                kept += keep[i];
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                keep[i] = !(uniforms[i] > probabilities[i]);
+                kept += keep[i];
+            }
+        }
+        if (kept != count) {
+            compact(keep.data(), removed);
+        }
+        return count - kept;
+    }
+
+    /**
+     * @brief Removes each row with the same @p probability, for rows that all share it.
+     *
+     * The number of removed rows is drawn from a binomial, and a uniformly random subset of that size is moved to the
+     * back with a partial Fisher-Yates shuffle and cut off, in O(removed). The order of the other rows changes.
+     *
+     * @return The number of removed rows.
+     */
+    size_t binomialFilter(RandomEngine &generator, double probability, BasicIndividualStore *removed);
+
+    /**
+     * @brief Moves the rows of several stores into memory from @p resource, one column at a time.
+     *
+     * Column c of stores[0], stores[1], ... ends up back to back, so scanning one column over all the stores is a
+     * single forward sweep through memory. Capacities are trimmed to the sizes, a later push_back moves that store out.
+     */
+    static void relocate(const std::vector<BasicIndividualStore *> &stores, std::pmr::memory_resource *resource);
+
+    /**
+     * @brief Shuffles the rows in place (Fisher-Yates).
+     */
+    void shuffle(RandomEngine &generator) {
+        for (size_t i = size(); i > 1; i--) {
+            swap(i - 1, Random::bounded(generator, static_cast<uint32_t>(i)));
+        }
+    }
+
+    /**
+     * @brief Materializes a row into an Individual.
+     */
+    [[nodiscard]] Individual toIndividual(size_t index) const;
+
+    /**
+     * @brief Gets the attribute values of all rows, with the same DISPERSAL filter as IndividualVector::get.
+     */
+    [[nodiscard]] std::vector<double> get(Attribute attribute) const;
+
+    Ref operator[](size_t index);
+
+    ConstRef operator[](size_t index) const;
+
+    Ref back();
+
+    [[nodiscard]] ConstRef back() const;
+
+    iterator begin();
+
+    iterator end();
+
+    [[nodiscard]] const_iterator begin() const;
+
+    [[nodiscard]] const_iterator end() const;
+
+    // Raw columns, valid until the next structural change (push_back, removal, clear)
+    Scalar *alphas() { return alpha.data(); }
+
+    Scalar *betas() { return beta.data(); }
+
+    Scalar *gammas() { return gamma.data(); }
+
+    Scalar *deltas() { return delta.data(); }
+
+    Scalar *drifts() { return drift.data(); }
+
+    Scalar *helps() { return help.data(); }
+
+    Scalar *survivals() { return survival.data(); }
+
+    Scalar *dispersals() { return dispersal.data(); }
+
+    int *ages() { return age.data(); }
+
+    RoleType *roles() { return role.data(); }
+
+    [[nodiscard]] const Scalar *alphas() const { return alpha.data(); }
+
+    [[nodiscard]] const Scalar *gammas() const { return gamma.data(); }
+
+    [[nodiscard]] const Scalar *drifts() const { return drift.data(); }
+
+    [[nodiscard]] const Scalar *helps() const { return help.data(); }
+
+    [[nodiscard]] const Scalar *survivals() const { return survival.data(); }
+
+    [[nodiscard]] const int *ages() const { return age.data(); }
+
+    [[nodiscard]] const RoleType *roles() const { return role.data(); }
+};
+
+
+/**
+ * @brief Read-only view of one row, mirroring the const part of the Individual API.
+ */
+template<class Scalar>
+class BasicIndividualStore<Scalar>::ConstRef {
+protected:
+    const BasicIndividualStore *store;
+    size_t index;
+
+public:
+    ConstRef(const BasicIndividualStore *store, size_t index) : store(store), index(index) {}
+
+    Scalar getAlpha() const { return store->alpha[index]; }
+
+    Scalar getBeta() const { return store->beta[index]; }
+
+    Scalar getGamma() const { return store->gamma[index]; }
+
+    Scalar getDelta() const { return store->delta[index]; }
+
+    Scalar getDrift() const { return store->drift[index]; }
+
+    Scalar getDispersal() const { return store->dispersal[index]; }
+
+    Scalar getHelp() const { return store->help[index]; }
+
+    Scalar getSurvival() const { return store->survival[index]; }
+
+    RoleType getRoleType() const { return store->role[index]; }
+
+    int getAge() const { return store->age[index]; }
+
+    bool isInherit() const { return store->inherit[index]; }
+
+    int getGroupIndex() const { return store->groupIndex[index]; }
+
+    int getAgeBecomeBreeder() const { return store->ageBecomeBreeder[index]; }
+
+    int getId() const { return store->id[index]; }
+
+    double get(Attribute attribute) const;
+
+    Individual toIndividual() const { return store->toIndividual(index); }
+};
+
+
+/**
+ * @brief Mutable view of one row, adding the Individual setters used while a row lives inside a store.
+ */
+template<class Scalar>
+class BasicIndividualStore<Scalar>::Ref : public ConstRef {
+    BasicIndividualStore *mutableStore() const { return const_cast<BasicIndividualStore *>(this->store); }
+
+public:
+    Ref(BasicIndividualStore *store, size_t index) : ConstRef(store, index) {}
+
+    void setRoleType(RoleType type) const;
+
+    void setInherit(bool inherit) const { mutableStore()->inherit[this->index] = inherit; }
+
+    void setGroupIndex(int groupIndex) const { mutableStore()->groupIndex[this->index] = groupIndex; }
+
+    void setId(int id) const { mutableStore()->id[this->index] = id; }
+
+    void setAgeBecomeBreeder() const { mutableStore()->ageBecomeBreeder[this->index] = this->getAge(); }
+
+    void increaseAge() const { mutableStore()->age[this->index]++; }
+};
+
+
+template<class Scalar>
+template<class Reference, class Store>
+class BasicIndividualStore<Scalar>::Iterator {
+    Store *store;
+    size_t index;
+
+public:
+    Iterator(Store *store, size_t index) : store(store), index(index) {}
+
+    Reference operator*() const { return Reference(store, index); }
+
+    Iterator &operator++() {
+        ++index;
+        return *this;
+    }
+
+    bool operator!=(const Iterator &other) const { return index != other.index; }
+
+    bool operator==(const Iterator &other) const { return index == other.index; }
+};
+
+
+extern template class BasicIndividualStore<float>;
+
+extern template class BasicIndividualStore<double>;
+
+using IndividualStore = BasicIndividualStore<Trait>;
+
+
+#endif //GROUP_AUGMENTATION_INDIVIDUALSTORE_H
@@ -67,8 +67,8 @@ double StatisticalFormulas::correlation(StatisticalFormulas y) {
     return correlation;
 }
 
-template <typename GetIndividualsFunc>
-double calculateRelatedness(const std::vector<Group> &groups, GetIndividualsFunc getIndividuals) {
+// Relatedness between the main breeder and the members of its group with the given role
+double calculateRelatedness(const std::vector<Group> &groups, RoleType roleType) {
     double correlation;
     int counter = 0;
     double meanX = 0, meanY = 0, stdevX = 0, stdevY = 0, sumX = 0.0, sumY = 0.0;
@@ -77,11 +77,13 @@ double calculateRelatedness(const std::vector<Group> &groups, GetIndividualsFunc
     // Calculate sums and means
     for (const Group &group: groups) {
         if (group.isBreederAlive()) {
-            auto individuals = getIndividuals(group);
-            if (!individuals.empty()) {
-                double mainBreederDrift = group.getMainBreeder().getDrift();
-                for (const Individual &individual: individuals) {
-                    sumX += individual.getDrift();
+            const IndividualStore &members = group.getMembers();
+            double mainBreederDrift = group.getMainBreeder().getDrift();
+            const Trait *drifts = members.drifts();
+            const RoleType *roles = members.roles();
+            for (size_t i = 0; i < members.size(); i++) {
+                if (roles[i] == roleType) {
+                    sumX += drifts[i];
                     sumY += mainBreederDrift;
                     counter++;
                 }
@@ -97,11 +99,13 @@ double calculateRelatedness(const std::vector<Group> &groups, GetIndividualsFunc
     // Calculate products for standard deviation and correlation
     for (const Group &group: groups) {
         if (group.isBreederAlive()) {
-            auto individuals = getIndividuals(group);
-            if (!individuals.empty()) {
-                double mainBreederDrift = group.getMainBreeder().getDrift();
-                for (const Individual &individual: individuals) {
-                    double X = (individual.getDrift() - meanX);
+            const IndividualStore &members = group.getMembers();
+            double mainBreederDrift = group.getMainBreeder().getDrift();
+            const Trait *drifts = members.drifts();
+            const RoleType *roles = members.roles();
+            for (size_t i = 0; i < members.size(); i++) {
+                if (roles[i] == roleType) {
+                    double X = (drifts[i] - meanX);
                     double Y = (mainBreederDrift - meanY);
 
                     sumProductXY += X * Y;
@@ -127,11 +131,11 @@ double calculateRelatedness(const std::vector<Group> &groups, GetIndividualsFunc
 }
 
 double StatisticalFormulas::calculateRelatednessHelpers(const std::vector<Group> &groups) {
-    return calculateRelatedness(groups, [](const Group &group) { return group.getHelpers(); });
+    return calculateRelatedness(groups, HELPER);
 }
 
 double StatisticalFormulas::calculateRelatednessBreeders(const std::vector<Group> &groups) {
-    return calculateRelatedness(groups, [](const Group &group) { return group.getSubordinateBreeders(); });
+    return calculateRelatedness(groups, BREEDER);
 }
 
 
@@ -147,10 +151,11 @@ void StatisticalFormulas::addValue(double toAdd) {
 
 void StatisticalFormulas::merge(const StatisticalFormulas statisticalFormulas) {
 
-    std::vector<double> result(this->individualValues.size() + statisticalFormulas.getValues().size());
+    const std::vector<double> &otherValues = statisticalFormulas.individualValues;
+    std::vector<double> result(this->individualValues.size() + otherValues.size());
 
-    std::merge(this->individualValues.begin(), this->individualValues.end(), statisticalFormulas.getValues().begin(),
-               statisticalFormulas.getValues().end(), result.begin());
+    std::merge(this->individualValues.begin(), this->individualValues.end(), otherValues.begin(),
+               otherValues.end(), result.begin());
     this->individualValues = result;
 
 
@@ -12,11 +12,11 @@ void Statistics::calculateStatistics(const Population &populationObj) {
     // Relatedness
     relatednessHelpers = 0.0, relatednessBreeders = 0.0;
 
-    IndividualVector mainBreeders;
-    IndividualVector subordinateBreeders;
-    IndividualVector allBreeders;
-    IndividualVector helpers;
-    IndividualVector individualsAll;
+    IndividualStore mainBreeders;
+    IndividualStore subordinateBreeders;
+    IndividualStore allBreeders;
+    IndividualStore helpers;
+    IndividualStore individualsAll;
     std::vector<double> groupSizes;
     std::vector<double> numSubBreeders;
     std::vector<double> cumHelp;
@@ -27,19 +27,19 @@ void Statistics::calculateStatistics(const Population &populationObj) {
     std::vector<double> offspringSubordinateBreeders;
     std::vector<double> totalOffspringGroups;
 
-    for (const Individual &helper: helpers) {
+    for (auto helper: helpers) {
         if (helper.getRoleType() != HELPER) {
             spdlog::warn("helper wrong class");
         }
     }
 
-    for (const Individual &floater: populationObj.getFloaters()) {
+    for (auto floater: populationObj.getFloaters()) {
         if (floater.getRoleType() != FLOATER) {
             spdlog::warn("floater wrong class");
         }
     }
 
-    for (const Individual &breeder: allBreeders) {
+    for (auto breeder: allBreeders) {
         if (breeder.getRoleType() != BREEDER) {
             spdlog::warn("breeder wrong class");
         }
@@ -48,17 +48,19 @@ void Statistics::calculateStatistics(const Population &populationObj) {
     mk = populationObj.getMk();
 
     for (const Group &group: populationObj.getGroups()) {
-        if (!group.isBreederAlive() && group.getHelpers().empty() && group.getSubordinateBreeders().empty()) {
+        if (group.isEmpty()) {
             emptyGroupsCount++;
         }
         if (group.isBreederAlive()) {
             mainBreeders.push_back(group.getMainBreeder());
         }
-        subordinateBreeders.merge(group.getSubordinateBreeders());
-        helpers.merge(group.getHelpers());
+        const IndividualStore &members = group.getMembers();
+        for (size_t i = 0; i < members.size(); i++) {
+            (members.roles()[i] == BREEDER ? subordinateBreeders : helpers).push_back(members, i);
+        }
 
         groupSizes.push_back(group.getGroupSize());
-        numSubBreeders.push_back(group.getSubordinateBreeders().size());
+        numSubBreeders.push_back(group.getSubordinateBreedersSize());
         cumHelp.push_back(group.getCumHelp());
         acceptanceRates.push_back(group.getAcceptanceRate());
         reproductiveShareRates.push_back(group.getReproductiveShareRate());
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <cstdint>
+#include "Arena.h"
+
+Arena::Arena(size_t blockSize) : blockSize(blockSize) {}
+
+void *Arena::do_allocate(size_t bytes, size_t alignment) {
+    while (currentBlock < blocks.size()) {
+        Block &block = blocks[currentBlock];
+        auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        size_t aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+        if (aligned + bytes <= block.size) {
+            offset = aligned + bytes;
+            return block.data.get() + aligned;
+        }
+        currentBlock++;
+        offset = 0;
+    }
+
+    // No room left in any block: grow by a block large enough for this request
+    size_t size = std::max(blockSize, bytes + alignment);
+    blocks.push_back({std::make_unique<std::byte[]>(size), size});
+    currentBlock = blocks.size() - 1;
+    return do_allocate(bytes, alignment);
+}
+
+void Arena::do_deallocate(void *, size_t, size_t) {
+    // memory is reclaimed by reset()
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+void Arena::reset() {
+    if (blocks.size() > 1) {
+        size_t total = capacity();
+        blocks.clear();
+        blocks.push_back({std::make_unique<std::byte[]>(total), total});
+    }
+    currentBlock = 0;
+    offset = 0;
+}
+
+size_t Arena::capacity() const {
+    size_t total = 0;
+    for (const Block &block: blocks) {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,56 @@
+#ifndef GROUP_AUGMENTATION_ARENA_H
+#define GROUP_AUGMENTATION_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class Arena
+ * @brief Bump allocator for the short-lived containers of a generation.
+ *
+ * Scratch stores and index vectors built during a generation (dispersers, sampled floaters, breeder candidates, ...)
+ * allocate from the arena through std::pmr containers. Deallocation is a no-op; all memory is reclaimed at once by
+ * reset() at the start of the next generation. Blocks are kept across resets, so once the arena has grown to the
+ * working set of a generation, later generations do not touch the heap.
+ */
+class Arena : public std::pmr::memory_resource {
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t currentBlock = 0; ///< Index of the block being bumped.
+    size_t offset = 0; ///< First free byte in the current block.
+    size_t blockSize; ///< Minimum size of a newly allocated block.
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+public:
+    explicit Arena(size_t blockSize = 64 * 1024);
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Releases everything allocated since the last reset.
+     *
+     * If the previous generation spilled over into several blocks, they are merged into a single block of the
+     * combined size, so a steady-state generation is served from one contiguous block.
+     */
+    void reset();
+
+    [[nodiscard]] size_t capacity() const;
+};
+
+
+#endif //GROUP_AUGMENTATION_ARENA_H
@@ -17,6 +17,11 @@ std::string Config::LOG_FILE;
 std::string Config::LOG_LEVEL;
 bool Config::LOG_TO_CONSOLE;
 bool Config::LOG_TO_FILE;
+bool Config::COMPACT_GROUP_LAYOUT = true;
+bool Config::FAST_SURVIVAL = false;
+bool Config::FUSED_GROUP_PASS = false;
+bool Config::BINOMIAL_MORTALITY = false;
+bool Config::COMPRESSED_FLOATERS = false;
 
 void Config::loadConfig() {
     std::string url;
@@ -50,6 +55,23 @@ void Config::loadConfig() {
     LOG_TO_CONSOLE = config["LOG_TO_CONSOLE"].as<bool>();
     LOG_TO_FILE = config["LOG_TO_FILE"].as<bool>();
     LOG_LEVEL = config["LOG_LEVEL"].as<std::string>();
+
+    // Execution options, optional so that existing config files keep working
+    if (config["COMPACT_GROUP_LAYOUT"]) {
+        COMPACT_GROUP_LAYOUT = config["COMPACT_GROUP_LAYOUT"].as<bool>();
+    }
+    if (config["FAST_SURVIVAL"]) {
+        FAST_SURVIVAL = config["FAST_SURVIVAL"].as<bool>();
+    }
+    if (config["FUSED_GROUP_PASS"]) {
+        FUSED_GROUP_PASS = config["FUSED_GROUP_PASS"].as<bool>();
+    }
+    if (config["BINOMIAL_MORTALITY"]) {
+        BINOMIAL_MORTALITY = config["BINOMIAL_MORTALITY"].as<bool>();
+    }
+    if (config["COMPRESSED_FLOATERS"]) {
+        COMPRESSED_FLOATERS = config["COMPRESSED_FLOATERS"].as<bool>();
+    }
 }
 
 int Config::calulateMaxThreads(int configThreads) {
@@ -102,6 +124,26 @@ const std::string &Config::GET_LOG_LEVEL() {
 }
 
 
+const bool &Config::IS_COMPACT_GROUP_LAYOUT() {
+    return COMPACT_GROUP_LAYOUT;
+}
+
+const bool &Config::IS_FAST_SURVIVAL() {
+    return FAST_SURVIVAL;
+}
+
+const bool &Config::IS_FUSED_GROUP_PASS() {
+    return FUSED_GROUP_PASS;
+}
+
+const bool &Config::IS_BINOMIAL_MORTALITY() {
+    return BINOMIAL_MORTALITY;
+}
+
+const bool &Config::IS_COMPRESSED_FLOATERS() {
+    return COMPRESSED_FLOATERS;
+}
+
 const std::string &Config::GET_COLLECTION_FILE() {
     return COLLECTION_FILE;
 }
@@ -37,6 +37,35 @@ class Config {
 
     static bool LOG_TO_FILE;
 
+    /**
+     * Copy the members of all groups into one contiguous layout every generation (optional, default true)
+     */
+    static bool COMPACT_GROUP_LAYOUT;
+
+    /**
+     * Use the vectorized exp approximation (relative error below 1e-13) for the survival of helpers and subordinate
+     * breeders instead of std::exp (optional, default false)
+     */
+    static bool FAST_SURVIVAL;
+
+    /**
+     * Run help, survival and mortality group by group in a single pass in the generations whose statistics are not
+     * recorded (optional, default false). Same results as the separate phases.
+     */
+    static bool FUSED_GROUP_PASS;
+
+    /**
+     * Draw the number of deaths of a cohort whose members share the same survival from a binomial and remove a random
+     * subset of that size (optional, default false). Same distribution, different random numbers.
+     */
+    static bool BINOMIAL_MORTALITY;
+
+    /**
+     * Keep floaters that are copies of each other as one cohort with a count (optional, default false), see
+     * FloaterCohorts. Same distribution, different random numbers.
+     */
+    static bool COMPRESSED_FLOATERS;
+
     /**
      * \brief Calculates the maximum number of threads to use for running simulations.
      *
@@ -78,6 +107,16 @@ public:
     static const bool &IS_LOG_TO_FILE();
 
     static const std::string &GET_LOG_LEVEL();
+
+    static const bool &IS_COMPACT_GROUP_LAYOUT();
+
+    static const bool &IS_FAST_SURVIVAL();
+
+    static const bool &IS_FUSED_GROUP_PASS();
+
+    static const bool &IS_BINOMIAL_MORTALITY();
+
+    static const bool &IS_COMPRESSED_FLOATERS();
 };
 
 
@@ -0,0 +1,48 @@
+#ifndef GROUP_AUGMENTATION_FASTMATH_H
+#define GROUP_AUGMENTATION_FASTMATH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Approximation of exp(x) with a relative error below 1e-13, written so that loops calling it vectorize.
+ *
+ * x is split into k * ln(2) + r with |r| <= ln(2) / 2, exp(r) is a degree 11 Taylor polynomial and 2^k is built
+ * directly in the exponent bits. There are no branches or calls; arguments are clamped to [-708, 709], so the result
+ * never overflows or becomes subnormal.
+ */
+inline double fastExp(double x) {
+    constexpr double LOG2E = 1.4426950408889634;
+    constexpr double LN2_HI = 6.93147180369123816490e-01; // ln(2) split in two for an exact k * LN2_HI
+    constexpr double LN2_LO = 1.90821492927058770002e-10;
+    constexpr double ROUND = 6755399441055744.0; // 1.5 * 2^52, adding it rounds to an integer kept in the low bits
+
+    x = std::min(std::max(x, -708.0), 709.0);
+    double shifted = x * LOG2E + ROUND;
+    double k = shifted - ROUND;
+    double r = x - k * LN2_HI - k * LN2_LO;
+
+    double p = 1.0 / 39916800;
+    p = p * r + 1.0 / 3628800;
+    p = p * r + 1.0 / 362880;
+    p = p * r + 1.0 / 40320;
+    p = p * r + 1.0 / 5040;
+    p = p * r + 1.0 / 720;
+    p = p * r + 1.0 / 120;
+    p = p * r + 1.0 / 24;
+    p = p * r + 1.0 / 6;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &shifted, sizeof bits);
+    bits = (bits + 1023) << 52; // the low bits of shifted hold k
+    double scale;
+    std::memcpy(&scale, &bits, sizeof scale);
+    return p * scale;
+}
+
+
+#endif //GROUP_AUGMENTATION_FASTMATH_H
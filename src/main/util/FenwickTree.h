@@ -0,0 +1,73 @@
+#ifndef GROUP_AUGMENTATION_FENWICKTREE_H
+#define GROUP_AUGMENTATION_FENWICKTREE_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @class FenwickTree
+ * @brief Integer weights over the positions 0 .. n-1 with prefix sums, weight updates and weighted search in
+ * O(log n) (Fenwick 1994, "A new data structure for cumulative frequency tables").
+ *
+ * Used to draw several individuals in a row with probabilities proportional to their weights, without replacement:
+ * find() the position of a uniform draw in [0, total()), then add() minus its weight to remove it.
+ */
+class FenwickTree {
+
+    std::pmr::vector<long> tree; ///< 1-based, tree[i] sums the weights of the positions i - (i & -i) .. i - 1.
+    long sum = 0;
+    size_t topStep = 0; ///< Largest power of two not above the size.
+
+public:
+
+    /**
+     * @brief Builds the tree over @p size weights in O(n).
+     */
+    template<class Weight>
+    FenwickTree(size_t size, Weight weight, std::pmr::memory_resource *resource) : tree(size + 1, 0, resource) {
+        for (size_t i = 1; i <= size; i++) {
+            const long value = weight(i - 1);
+            assert(value >= 0);
+            sum += value;
+            tree[i] += value;
+            const size_t parent = i + (i & -i);
+            if (parent <= size) {
+                tree[parent] += tree[i];
+            }
+        }
+        for (topStep = 1; topStep * 2 <= size; topStep *= 2) {}
+    }
+
+    [[nodiscard]] long total() const { return sum; }
+
+    /**
+     * @brief Adds @p delta to the weight of @p position.
+     */
+    void add(size_t position, long delta) {
+        sum += delta;
+        for (size_t i = position + 1; i < tree.size(); i += i & -i) {
+            tree[i] += delta;
+        }
+    }
+
+    /**
+     * @brief The position whose weight interval contains @p target: the first position where the prefix sum of the
+     * weights, itself included, exceeds @p target. Requires 0 <= target < total().
+     */
+    [[nodiscard]] size_t find(long target) const {
+        assert(target >= 0 && target < sum);
+        size_t position = 0;
+        for (size_t step = topStep; step > 0; step /= 2) {
+            if (position + step < tree.size() && tree[position + step] <= target) {
+                position += step;
+                target -= tree[position];
+            }
+        }
+        return position;
+    }
+};
+
+
+#endif //GROUP_AUGMENTATION_FENWICKTREE_H
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <iomanip>
 #include "Config.h"
+#include "../model/Trait.h"
 
 
 using namespace std;
@@ -168,9 +169,9 @@ void FilePrinter::printHeader(std::ofstream &writer) {
 FilePrinter::FilePrinter(std::shared_ptr<Parameters> &parameters) : parameters(parameters) {
     // Create the output files
     this->mainWriter = std::make_unique<std::ofstream>(
-        Config::GET_OUTPUT_DIR() + "/" + "main_" + parameters->getName() + ".txt");
+        Config::GET_OUTPUT_DIR() + "/" + "main_" + parameters->getName() + TRAIT_FILE_SUFFIX + ".txt");
     this->lastGenerationWriter = std::make_unique<std::ofstream>(
-        Config::GET_OUTPUT_DIR() + "/" + "last_generation_" + parameters->getName() + ".txt");
+        Config::GET_OUTPUT_DIR() + "/" + "last_generation_" + parameters->getName() + TRAIT_FILE_SUFFIX + ".txt");
 }
 
 FilePrinter::~FilePrinter() {
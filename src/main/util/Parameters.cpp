@@ -4,6 +4,7 @@
 #include "Parameters.h"
 
 #include "Config.h"
+#include "../model/VitalRates.h"
 #include "spdlog/spdlog.h"
 
 
@@ -70,11 +71,8 @@ Parameters::Parameters(const string &filename, const int replica) : replica(repl
     this->MUTATION_DRIFT = config["MUTATION_DRIFT"].as<double>();
     this->STEP_DRIFT = config["STEP_DRIFT"].as<double>();
 
-    this->driftUniform = uniform_real_distribution<double>(100, 200);
-    this->uniform = uniform_real_distribution<double>(0, 1);
-
-
-    this->generator = new std::default_random_engine(SEED + replica);
+    this->generator = new RandomEngine(stream(0, NO_VALUE, RandomPhase::INITIALIZATION));
+    this->vitalRates = std::make_shared<const VitalRates>(*this);
 }
 
 Parameters::~Parameters() {
@@ -268,10 +266,19 @@ std::string Parameters::removeExtension(std::string filename) {
 }
 
 
-default_random_engine *Parameters::getGenerator() const {
+RandomEngine *Parameters::getGenerator() const {
     return generator;
 }
 
+RandomEngine Parameters::stream(int generation, int group, RandomPhase phase) const {
+    const uint64_t key = static_cast<uint64_t>(SEED) | static_cast<uint64_t>(replica) << 32;
+    return {key, static_cast<uint32_t>(phase), static_cast<uint32_t>(group), static_cast<uint32_t>(generation)};
+}
+
+const VitalRates &Parameters::getVitalRates() const {
+    return *vitalRates;
+}
+
 
 int Parameters::getReplica() const {
     return replica;
@@ -280,6 +287,6 @@ int Parameters::getReplica() const {
 shared_ptr<Parameters> Parameters::cloneWithIncrementedReplica(int newReplica) {
     auto deepCopy = std::make_shared<Parameters>(*this); // Use copy constructor
     deepCopy->replica = newReplica; // Increment newReplica
-    deepCopy->generator = new std::default_random_engine(SEED + newReplica);
+    deepCopy->generator = new RandomEngine(deepCopy->stream(0, NO_VALUE, RandomPhase::INITIALIZATION));
     return deepCopy;
 }
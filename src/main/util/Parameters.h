@@ -3,12 +3,13 @@
 
 #include <string>
 #include <fstream>
-#include <random>
+#include "Random.h"
 #include <memory>
 #include <iomanip>
 
 
 class Statistics;   // Forward declaration
+class VitalRates;
 
 /**
  * @class Parameters
@@ -114,7 +115,9 @@ private:
     double MUTATION_DRIFT;        ///< Mutation rate in the neutral selected value to track level of relatedness.
     double STEP_DRIFT;            ///< Mutation step size in the neutral genetic value to track level of relatedness.
 
-    std::default_random_engine *generator; ///< A pointer to the random number generator.
+    RandomEngine *generator; ///< A pointer to the random number generator.
+
+    std::shared_ptr<const VitalRates> vitalRates; ///< Survival and fecundity precomputed from the values above.
 
     std::string removeExtension(std::string url); ///< Helper function to get the name of the simulation from a URL.
 
@@ -122,14 +125,11 @@ private:
 
 
 
-    double idCounter = 0;
+    int idCounter = 0;
     Statistics *results;
 
 public:
 
-    std::uniform_real_distribution<double> driftUniform; ///< A uniform real distribution for drift.
-    std::uniform_real_distribution<double> uniform; ///< A uniform real distribution.
-
     /**
      * @brief Prints the parameters to the console.
      */
@@ -226,10 +226,27 @@ public:
 
     static const int NO_VALUE = -1; ///< A constant representing no value.
 
-    std::default_random_engine *getGenerator() const;
+    /**
+     * @brief Generator of the replica for the draws made while the population is set up.
+     */
+    RandomEngine *getGenerator() const;
+
+    /**
+     * @brief Independent random stream of one phase of one group in one generation of this replica.
+     *
+     * @param group Index of the group, or NO_VALUE for the draws that concern the whole population.
+     */
+    RandomEngine stream(int generation, int group, RandomPhase phase) const;
+
+    const VitalRates &getVitalRates() const;
 
-    double nextId() {
-        return idCounter++;
+    /**
+     * @brief Reserves @p count consecutive ids and returns the first one.
+     */
+    int nextId(int count = 1) {
+        const int first = idCounter;
+        idCounter += count;
+        return first;
     }
 
 };
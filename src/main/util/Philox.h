@@ -0,0 +1,124 @@
+#ifndef GROUP_AUGMENTATION_PHILOX_H
+#define GROUP_AUGMENTATION_PHILOX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Philox
+ * @brief Counter-based random number engine, Philox4x32-10 (Salmon et al. 2011, "Parallel random numbers: as easy
+ * as 1, 2, 3").
+ *
+ * Each 128-bit block of output is a pure function of a 64-bit key and a 128-bit counter. The upper three words of
+ * the counter name a stream, and the lowest word counts the blocks drawn from it. Any stream can therefore be
+ * generated on its own, in any order, without touching the state of other streams. Satisfies
+ * UniformRandomBitGenerator with 64-bit results, two per block.
+ */
+class Philox {
+public:
+    using result_type = uint64_t;
+    using Block = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+private:
+    Key key;
+    Block counter;
+    Block output{};
+    int available = 0; ///< 64-bit values of output not handed out yet.
+
+    static void round(Block &block, const Key &key) {
+        const uint64_t product0 = static_cast<uint64_t>(0xD2511F53) * block[0];
+        const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57) * block[2];
+        block = {static_cast<uint32_t>(product1 >> 32) ^ block[1] ^ key[0], static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ block[3] ^ key[1], static_cast<uint32_t>(product0)};
+    }
+
+public:
+    /**
+     * @brief The stream (@p stream0, @p stream1, @p stream2) of the given key, starting at its first block.
+     */
+    Philox(uint64_t key, uint32_t stream0, uint32_t stream1, uint32_t stream2) :
+            key{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)},
+            counter{0, stream0, stream1, stream2} {}
+
+    explicit Philox(uint64_t seed = 0) : Philox(seed, 0, 0, 0) {}
+
+    /**
+     * @brief The Philox4x32-10 bijection of one counter value.
+     */
+    static Block generate(Block block, Key key) {
+        for (int i = 0; i < 10; i++) {
+            if (i > 0) {
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            round(block, key);
+        }
+        return block;
+    }
+
+    result_type operator()() {
+        if (available == 0) {
+            output = generate(counter, key);
+            counter[0]++;
+            available = 2;
+        }
+        available--;
+        const int word = available == 1 ? 0 : 2;
+        return static_cast<uint64_t>(output[word]) | static_cast<uint64_t>(output[word + 1]) << 32;
+    }
+
+    /**
+     * @brief Writes the next @p count outputs to @p out, the same values as @p count calls of operator().
+     *
+     * Whole blocks are generated LANES at a time with the words of the blocks in separate arrays, so the rounds are
+     * plain loops over lanes that the compiler can vectorize.
+     */
+    void fill(result_type *out, size_t count) {
+        for (; available > 0 && count > 0; count--) {
+            *out++ = (*this)();
+        }
+        constexpr int LANES = 4;
+        for (; count >= 2 * LANES; count -= 2 * LANES, out += 2 * LANES) {
+            uint32_t x0[LANES], x1[LANES], x2[LANES], x3[LANES];
+            for (int lane = 0; lane < LANES; lane++) {
+                x0[lane] = counter[0] + lane;
+                x1[lane] = counter[1];
+                x2[lane] = counter[2];
+                x3[lane] = counter[3];
+            }
+            Key roundKey = key;
+            for (int i = 0; i < 10; i++) {
+                if (i > 0) {
+                    roundKey[0] += 0x9E3779B9;
+                    roundKey[1] += 0xBB67AE85;
+                }
+                for (int lane = 0; lane < LANES; lane++) {
+                    const uint64_t product0 = static_cast<uint64_t>(0xD2511F53) * x0[lane];
+                    const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57) * x2[lane];
+                    x0[lane] = static_cast<uint32_t>(product1 >> 32) ^ x1[lane] ^ roundKey[0];
+                    x1[lane] = static_cast<uint32_t>(product1);
+                    x2[lane] = static_cast<uint32_t>(product0 >> 32) ^ x3[lane] ^ roundKey[1];
+                    x3[lane] = static_cast<uint32_t>(product0);
+                }
+            }
+            for (int lane = 0; lane < LANES; lane++) {
+                out[2 * lane] = static_cast<uint64_t>(x0[lane]) | static_cast<uint64_t>(x1[lane]) << 32;
+                out[2 * lane + 1] = static_cast<uint64_t>(x2[lane]) | static_cast<uint64_t>(x3[lane]) << 32;
+            }
+            counter[0] += LANES;
+        }
+        for (; count > 0; count--) {
+            *out++ = (*this)();
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+};
+
+
+#endif //GROUP_AUGMENTATION_PHILOX_H
@@ -0,0 +1,228 @@
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include "Random.h"
+
+namespace {
+    // Ziggurat for the normal distribution with 128 blocks of equal area (Marsaglia and Tsang, in the ZIGNOR form of
+    // Doornik 2005)
+    constexpr int BLOCKS = 128;
+    constexpr double TAIL_START = 3.442619855899;
+    constexpr double BLOCK_AREA = 9.91256303526217e-3;
+
+    struct Ziggurat {
+        std::array<double, BLOCKS + 1> x{};
+        std::array<double, BLOCKS> ratio{};
+
+        Ziggurat() {
+            double f = std::exp(-0.5 * TAIL_START * TAIL_START);
+            x[0] = BLOCK_AREA / f;
+            x[1] = TAIL_START;
+            x[BLOCKS] = 0;
+            for (int i = 2; i < BLOCKS; i++) {
+                x[i] = std::sqrt(-2 * std::log(BLOCK_AREA / x[i - 1] + f));
+                f = std::exp(-0.5 * x[i] * x[i]);
+            }
+            for (int i = 0; i < BLOCKS; i++) {
+                ratio[i] = x[i + 1] / x[i];
+            }
+        }
+    };
+
+    const Ziggurat ziggurat;
+
+    // Uniform in (0, 1], safe to take the logarithm of
+    double uniformPositive(RandomEngine &engine) {
+        return (static_cast<double>(engine() >> 11) + 1) * 0x1.0p-53;
+    }
+
+    double normalTail(RandomEngine &engine, bool negative) {
+        double x, y;
+        do {
+            x = std::log(uniformPositive(engine)) / TAIL_START;
+            y = std::log(uniformPositive(engine));
+        } while (-2 * y < x * x);
+        return negative ? x - TAIL_START : TAIL_START - x;
+    }
+
+    int poissonInversion(RandomEngine &engine, double mean) {
+        double probability = std::exp(-mean);
+        double u = Random::uniform(engine);
+        int k = 0;
+        while (u > probability) {
+            u -= probability;
+            k++;
+            probability *= mean / k;
+            if (probability == 0) {
+                break; // u was within rounding of 1
+            }
+        }
+        return k;
+    }
+
+    // Kachitvichyanukul and Schmeiser (1988), BINV; probability <= 0.5
+    int binomialInversion(RandomEngine &engine, int trials, double probability) {
+        const double ratio = probability / (1 - probability);
+        const double a = (trials + 1) * ratio;
+        double term = std::exp(trials * std::log1p(-probability));
+        double u = Random::uniform(engine);
+        int k = 0;
+        while (u > term && k < trials) {
+            u -= term;
+            k++;
+            term *= a / k - ratio;
+        }
+        return k;
+    }
+
+    // log(k!) - (k + 1/2) log(k + 1) + k + 1 - log(2 pi) / 2, the error of Stirling's approximation
+    double stirlingCorrection(int k) {
+        const double k1 = k + 1.0;
+        return std::lgamma(k1) - (k + 0.5) * std::log(k1) + k1 - 0.9189385332046728;
+    }
+
+    // Hormann (1993), The generation of binomial random variates; probability <= 0.5 and mean >= 10
+    int binomialBTRD(RandomEngine &engine, int trials, double probability) {
+        const int mode = static_cast<int>((trials + 1) * probability);
+        const double r = probability / (1 - probability);
+        const double nr = (trials + 1) * r;
+        const double npq = trials * probability * (1 - probability);
+        const double sqrtNpq = std::sqrt(npq);
+        const double b = 1.15 + 2.53 * sqrtNpq;
+        const double a = -0.0873 + 0.0248 * b + 0.01 * probability;
+        const double c = trials * probability + 0.5;
+        const double alpha = (2.83 + 5.1 / b) * sqrtNpq;
+        const double vr = 0.92 - 4.2 / b;
+        const double urvr = 0.86 * vr;
+
+        while (true) {
+            double u;
+            double v = Random::uniform(engine);
+            if (v <= urvr) {
+                u = v / vr - 0.43;
+                return static_cast<int>(std::floor((2 * a / (0.5 - std::fabs(u)) + b) * u + c));
+            }
+            if (v >= vr) {
+                u = Random::uniform(engine) - 0.5;
+            } else {
+                u = v / vr - 0.93;
+                u = (u < 0 ? -0.5 : 0.5) - u;
+                v = Random::uniform(engine) * vr;
+            }
+            const double us = 0.5 - std::fabs(u);
+            const double kReal = std::floor((2 * a / us + b) * u + c);
+            if (kReal < 0 || kReal > trials) {
+                continue;
+            }
+            const int k = static_cast<int>(kReal);
+            v = v * alpha / (a / (us * us) + b);
+            const int km = std::abs(k - mode);
+            if (km <= 15) {
+                // Ratio of the probabilities of k and the mode, by recursion
+                double f = 1;
+                if (mode < k) {
+                    for (int i = mode + 1; i <= k; i++) {
+                        f *= nr / i - r;
+                    }
+                } else {
+                    for (int i = k + 1; i <= mode; i++) {
+                        v *= nr / i - r;
+                    }
+                }
+                if (v <= f) {
+                    return k;
+                }
+                continue;
+            }
+            v = std::log(v);
+            const double rho = (km / npq) * (((km / 3.0 + 0.625) * km + 1.0 / 6) / npq + 0.5);
+            const double t = -static_cast<double>(km) * km / (2 * npq);
+            if (v < t - rho) {
+                return k;
+            }
+            if (v > t + rho) {
+                continue;
+            }
+            const double nm = trials - mode + 1;
+            const double h = (mode + 0.5) * std::log((mode + 1) / (r * nm)) + stirlingCorrection(mode) +
+                             stirlingCorrection(trials - mode);
+            const double nk = trials - k + 1;
+            if (v <= h + (trials + 1) * std::log(nm / nk) + (k + 0.5) * std::log(nk * r / (k + 1)) -
+                     stirlingCorrection(k) - stirlingCorrection(trials - k)) {
+                return k;
+            }
+        }
+    }
+
+    // Hormann (1993), The transformed rejection method for generating Poisson random variables
+    int poissonPTRS(RandomEngine &engine, double mean) {
+        const double sqrtMean = std::sqrt(mean);
+        const double logMean = std::log(mean);
+        const double b = 0.931 + 2.53 * sqrtMean;
+        const double a = -0.059 + 0.02483 * b;
+        const double inverseAlpha = 1.1239 + 1.1328 / (b - 3.4);
+        const double vr = 0.9277 - 3.6224 / (b - 2);
+
+        while (true) {
+            double u = Random::uniform(engine) - 0.5;
+            double v = Random::uniform(engine);
+            double us = 0.5 - std::fabs(u);
+            double k = std::floor((2 * a / us + b) * u + mean + 0.43);
+            if (us >= 0.07 && v <= vr) {
+                return static_cast<int>(k);
+            }
+            if (k < 0 || (us < 0.013 && v > us)) {
+                continue;
+            }
+            if (std::log(v) + std::log(inverseAlpha) - std::log(a / (us * us) + b) <=
+                -mean + k * logMean - std::lgamma(k + 1)) {
+                return static_cast<int>(k);
+            }
+        }
+    }
+}
+
+double Random::normal(RandomEngine &engine) {
+    while (true) {
+        const uint64_t bits = engine();
+        const double u = static_cast<double>(bits >> 11) * 0x1.0p-52 - 1; // [-1, 1)
+        const int block = static_cast<int>(bits & (BLOCKS - 1));
+        if (std::fabs(u) < ziggurat.ratio[block]) {
+            return u * ziggurat.x[block];
+        }
+        if (block == 0) {
+            return normalTail(engine, u < 0);
+        }
+        const double x = u * ziggurat.x[block];
+        const double f0 = std::exp(-0.5 * (ziggurat.x[block] * ziggurat.x[block] - x * x));
+        const double f1 = std::exp(-0.5 * (ziggurat.x[block + 1] * ziggurat.x[block + 1] - x * x));
+        if (f1 + uniform(engine) * (f0 - f1) < 1.0) {
+            return x;
+        }
+    }
+}
+
+int Random::poisson(RandomEngine &engine, double mean) {
+    if (mean <= 0) {
+        return 0;
+    }
+    return mean < 10 ? poissonInversion(engine, mean) : poissonPTRS(engine, mean);
+}
+
+int Random::binomial(RandomEngine &engine, int trials, double probability) {
+    if (trials <= 0 || probability <= 0) {
+        return 0;
+    }
+    if (probability >= 1) {
+        return trials;
+    }
+    if (probability > 0.5) {
+        return trials - binomial(engine, trials, 1 - probability);
+    }
+    return trials * probability < 10 ? binomialInversion(engine, trials, probability)
+                                     : binomialBTRD(engine, trials, probability);
+}
+
+long Random::geometric(RandomEngine &engine, double logFailure) {
+    return static_cast<long>(std::floor(std::log(uniformPositive(engine)) / logFailure));
+}
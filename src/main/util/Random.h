@@ -0,0 +1,120 @@
+#ifndef GROUP_AUGMENTATION_RANDOM_H
+#define GROUP_AUGMENTATION_RANDOM_H
+
+#include <cstdint>
+#include <algorithm>
+#include "Philox.h"
+
+/**
+ * @brief The random number engine of the simulation.
+ *
+ * Counter-based, so that every (replica, generation, group, phase) has its own independent stream; see
+ * Parameters::stream().
+ */
+using RandomEngine = Philox;
+
+/**
+ * @brief The phases of a generation that draw random numbers, each with its own stream.
+ */
+enum class RandomPhase : uint32_t {
+    INITIALIZATION,
+    DISPERSAL,
+    FLOATER_MORTALITY,
+    IMMIGRATION,
+    BREEDER_SELECTION,
+    MORTALITY,
+    ENVIRONMENT,
+    REPRODUCTION,
+    RELATEDNESS
+};
+
+/**
+ * @struct Random
+ * @brief In-tree samplers, used instead of the <random> distributions wherever the model draws a random number.
+ *
+ * The algorithms of the standard distributions are left to the implementation, so the same seed gives different
+ * simulations with libstdc++ and libc++, and the distributions are comparatively slow to construct. These samplers
+ * fix the algorithms, so the draws no longer depend on the standard library's choice, and none of them keeps state
+ * between calls. They still call the math library, though: the inversion paths for small means call exp and log1p
+ * on every draw, the ziggurat wedge calls exp, the geometric skip calls log, and the paths for large means call log
+ * and lgamma. The math library is not required to round these correctly, so draws are only reproducible with the
+ * same libm, not across every toolchain.
+ */
+struct Random {
+
+    /**
+     * @brief Uniform double in [0, 1) with 53 random bits.
+     */
+    static double uniform(RandomEngine &engine) {
+        return static_cast<double>(engine() >> 11) * 0x1.0p-53;
+    }
+
+    /**
+     * @brief Uniform double in [min, max).
+     */
+    static double uniform(RandomEngine &engine, double min, double max) {
+        return min + (max - min) * uniform(engine);
+    }
+
+    /**
+     * @brief Uniform integer in [0, range), with Lemire's nearly divisionless method. @p range must be positive.
+     */
+    static uint32_t bounded(RandomEngine &engine, uint32_t range) {
+        uint64_t product = (engine() >> 32) * static_cast<uint64_t>(range);
+        auto low = static_cast<uint32_t>(product);
+        if (low < range) {
+            const uint32_t threshold = -range % range;
+            while (low < threshold) {
+                product = (engine() >> 32) * static_cast<uint64_t>(range);
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    /**
+     * @brief Uniform integer in [min, max], both included.
+     */
+    static int uniformInt(RandomEngine &engine, int min, int max) {
+        return min + static_cast<int>(bounded(engine, static_cast<uint32_t>(max - min) + 1));
+    }
+
+    /**
+     * @brief Standard normal deviate, with the ziggurat method (128 layers).
+     */
+    static double normal(RandomEngine &engine);
+
+    static double normal(RandomEngine &engine, double mean, double standardDeviation) {
+        return mean + standardDeviation * normal(engine);
+    }
+
+    /**
+     * @brief Poisson deviate: sequential inversion for means below 10, Hormann's PTRS rejection above.
+     */
+    static int poisson(RandomEngine &engine, double mean);
+
+    /**
+     * @brief Binomial deviate: inversion when n * min(p, 1 - p) is below 10, Hormann's BTRD rejection above.
+     */
+    static int binomial(RandomEngine &engine, int trials, double probability);
+
+    /**
+     * @brief Number of failures before the first success of Bernoulli trials, by inversion.
+     *
+     * @param logFailure log(1 - p), negative; precomputed by the caller since p rarely changes.
+     */
+    static long geometric(RandomEngine &engine, double logFailure);
+
+    /**
+     * @brief Fisher-Yates shuffle of a random access range.
+     */
+    template<class RandomIt>
+    static void shuffle(RandomIt first, RandomIt last, RandomEngine &engine) {
+        for (auto i = last - first; i > 1; i--) {
+            std::iter_swap(first + (i - 1), first + bounded(engine, static_cast<uint32_t>(i)));
+        }
+    }
+};
+
+
+#endif //GROUP_AUGMENTATION_RANDOM_H
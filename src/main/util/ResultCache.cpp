@@ -15,15 +15,15 @@ void ResultCache::writeToCacheLastGeneration(Simulation *simulation, const Popul
         if (counter < 100) {
             this->writeToCacheIndividual(group.getMainBreeder(), simulation->getGeneration(), groupID);
 
-            for (auto const &helper: group.getHelpers()) {
-                this->writeToCacheIndividual(helper, simulation->getGeneration(), groupID);
+            for (auto helper: group.getHelpers()) {
+                this->writeToCacheIndividual(helper.toIndividual(), simulation->getGeneration(), groupID);
             }
             counter++;
         }
         groupID++;
     }
-    for (auto const &floater: populationObj.getFloaters()) {
-        this->writeToCacheIndividual(floater, simulation->getGeneration(), groupID);
+    for (auto floater: populationObj.getFloaters()) {
+        this->writeToCacheIndividual(floater.toIndividual(), simulation->getGeneration(), groupID);
     }
 }
 
@@ -0,0 +1,50 @@
+#ifndef GROUP_AUGMENTATION_UNIFORMBUFFER_H
+#define GROUP_AUGMENTATION_UNIFORMBUFFER_H
+
+#include <array>
+#include "Random.h"
+
+/**
+ * @class UniformBuffer
+ * @brief Uniform doubles in [0, 1) from one random stream, generated a block at a time and handed out by a cursor.
+ *
+ * Gives the same sequence as calling Random::uniform() on the stream, but the engine runs in bulk (Philox::fill) and
+ * each draw is a load and an increment. Meant for the phases that draw one uniform per individual; the block is
+ * small, so few values are wasted when a stream is dropped after a handful of draws.
+ */
+class UniformBuffer {
+public:
+    static constexpr int BLOCK = 16;
+
+private:
+    RandomEngine engine;
+    std::array<double, BLOCK> values{};
+    int cursor = BLOCK;
+
+    void refill() {
+        std::array<RandomEngine::result_type, BLOCK> bits;
+        engine.fill(bits.data(), BLOCK);
+        for (int i = 0; i < BLOCK; i++) {
+            values[i] = static_cast<double>(bits[i] >> 11) * 0x1.0p-53;
+        }
+        cursor = 0;
+    }
+
+public:
+    explicit UniformBuffer(const RandomEngine &engine) : engine(engine) {}
+
+    double operator()() {
+        if (cursor == BLOCK) {
+            refill();
+        }
+        return values[cursor++];
+    }
+
+    /**
+     * @brief The stream behind the buffer, for draws that are not uniforms. It continues after the buffered values.
+     */
+    RandomEngine &getEngine() { return engine; }
+};
+
+
+#endif //GROUP_AUGMENTATION_UNIFORMBUFFER_H
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "../../../main/model/container/FloaterCohorts.h"
+
+namespace {
+    IndividualStore makeFloaters(Parameters &parameters, int clones, int count) {
+        IndividualStore floaters;
+        Individual floater(FLOATER, parameters);
+        for (int i = 0; i < count; i++) {
+            floaters.push_back(floater);
+            floaters.back().setId(i);
+            if (i % clones == clones - 1) {
+                floater = Individual(FLOATER, parameters); // new random drift
+            }
+        }
+        return floaters;
+    }
+}
+
+TEST(FloaterCohortsTest, CopiesShareACohort) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    FloaterCohorts cohorts;
+
+    //when
+    cohorts.add(makeFloaters(*parameters, 10, 100), std::pmr::get_default_resource());
+    IndividualStore older = makeFloaters(*parameters, 10, 10);
+    older.ages()[0] = 2;
+    cohorts.add(older, std::pmr::get_default_resource());
+
+    //then
+    EXPECT_EQ(cohorts.size(), 110);
+    EXPECT_EQ(cohorts.cohorts(), 12);
+    IndividualStore expanded;
+    cohorts.expand(expanded);
+    EXPECT_EQ(expanded.size(), 110);
+}
+
+TEST(FloaterCohortsTest, TakeAndMortality) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    FloaterCohorts cohorts;
+    cohorts.add(makeFloaters(*parameters, 25, 100), std::pmr::get_default_resource());
+    RandomEngine generator(7);
+
+    //when
+    IndividualStore taken;
+    cohorts.take(generator, 30, taken, 1000);
+
+    //then
+    EXPECT_EQ(taken.size(), 30);
+    EXPECT_EQ(cohorts.size(), 70);
+    std::set<int> ids;
+    for (auto floater: taken) {
+        ids.insert(floater.getId());
+        EXPECT_EQ(floater.getRoleType(), FLOATER);
+    }
+    EXPECT_EQ(ids.size(), 30);
+    EXPECT_EQ(*ids.begin(), 1000);
+
+    //when
+    IndividualStore &representatives = cohorts.getRepresentatives();
+    for (size_t i = 0; i < representatives.size(); i++) {
+        representatives.survivals()[i] = i == 0 ? 0 : 1;
+    }
+    const int firstCohort = cohorts.getCount(0);
+    size_t deaths = cohorts.mortality(generator);
+
+    //then
+    EXPECT_EQ(deaths, firstCohort);
+    EXPECT_EQ(cohorts.size(), 70 - firstCohort);
+    EXPECT_EQ(cohorts.cohorts(), 3);
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include "../../../main/model/container/IndividualStore.h"
+
+namespace {
+    std::shared_ptr<Parameters> loadParameters() {
+        return std::make_shared<Parameters>("unit_tests.yml", 0);
+    }
+}
+
+TEST(IndividualStoreTest, RoundTripIndividual) {
+    //given
+    auto parameters = loadParameters();
+    IndividualStore store;
+    Individual helper(HELPER, *parameters);
+    helper.setInherit(false);
+
+    //when
+    store.push_back(helper);
+    Individual copy = store.toIndividual(0);
+
+    //then
+    EXPECT_EQ(store.size(), 1);
+    EXPECT_TRUE(copy == helper);
+    EXPECT_EQ(copy.getAlpha(), helper.getAlpha());
+    EXPECT_EQ(copy.getDrift(), helper.getDrift());
+    EXPECT_EQ(copy.getAge(), helper.getAge());
+    EXPECT_EQ(copy.getRoleType(), HELPER);
+    EXPECT_FALSE(copy.isInherit());
+    EXPECT_EQ(store[0].getDrift(), helper.getDrift());
+}
+
+TEST(IndividualStoreTest, RemoveIndividualMovesLastRow) {
+    //given
+    auto parameters = loadParameters();
+    IndividualStore store;
+    for (int i = 0; i < 4; i++) {
+        store.push_back(Individual(HELPER, *parameters));
+        store.ages()[i] = i + 1;
+    }
+
+    //when
+    store.removeIndividual(1);
+
+    //then
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_EQ(store[0].getAge(), 1);
+    EXPECT_EQ(store[1].getAge(), 4);
+    EXPECT_EQ(store[2].getAge(), 3);
+
+    //when
+    store.erase(0);
+
+    //then
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store[0].getAge(), 4);
+    EXPECT_EQ(store[1].getAge(), 3);
+}
+
+TEST(IndividualStoreTest, RefUpdatesColumns) {
+    //given
+    auto parameters = loadParameters();
+    IndividualStore store;
+    store.push_back(Individual(HELPER, *parameters));
+    store.helps()[0] = 0.5;
+
+    //when
+    store[0].setRoleType(FLOATER);
+    store[0].increaseAge();
+
+    //then
+    EXPECT_EQ(store.roles()[0], FLOATER);
+    EXPECT_EQ(store.helps()[0], 0);
+    EXPECT_EQ(store.get(AGE), std::vector<double>{2});
+    EXPECT_TRUE(store.get(DISPERSAL).empty()); // dispersal is only reported for individuals of age 1
+}
+
+TEST(IndividualStoreTest, SinglePrecisionStore) {
+    //given
+    auto parameters = loadParameters();
+    BasicIndividualStore<float> store;
+    Individual helper(HELPER, *parameters);
+
+    //when
+    store.push_back(helper);
+
+    //then
+    EXPECT_EQ(store[0].getDrift(), static_cast<float>(helper.getDrift()));
+    EXPECT_FLOAT_EQ(store.toIndividual(0).getDrift(), helper.getDrift());
+    EXPECT_EQ(store[0].getAge(), helper.getAge());
+}
+
+TEST(IndividualStoreTest, BernoulliFilterKeepsOrder) {
+    //given
+    auto parameters = loadParameters();
+    IndividualStore store, removed;
+    for (int i = 0; i < 5; i++) {
+        store.push_back(Individual(HELPER, *parameters));
+        store.ages()[i] = i + 1;
+        store.survivals()[i] = 0.5;
+    }
+    std::vector<double> draws{0.1, 0.9, 0.2, 0.7, 0.5};
+    size_t next = 0;
+
+    //when
+    size_t count = store.bernoulliFilter([&] { return draws[next++]; }, store.survivals(),
+                                         IndividualStore::Removal::IF_ABOVE, &removed,
+                                         std::pmr::get_default_resource());
+
+    //then
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(store.get(AGE), (std::vector<double>{1, 3, 5}));
+    EXPECT_EQ(removed.get(AGE), (std::vector<double>{2, 4}));
+    EXPECT_EQ(removed.survivals()[1], 0.5);
+}
+
+TEST(IndividualStoreTest, BinomialFilterPartitionsRows) {
+    //given
+    auto parameters = loadParameters();
+    IndividualStore store, removed;
+    for (int i = 0; i < 1000; i++) {
+        store.push_back(Individual(FLOATER, *parameters));
+        store.ages()[i] = i;
+    }
+    RandomEngine generator(42);
+
+    //when
+    size_t count = store.binomialFilter(generator, 0.3, &removed);
+
+    //then
+    EXPECT_EQ(removed.size(), count);
+    EXPECT_EQ(store.size() + removed.size(), 1000);
+    EXPECT_NEAR(static_cast<double>(count), 300, 5 * std::sqrt(1000 * 0.3 * 0.7));
+    std::vector<double> ages = store.get(AGE);
+    std::vector<double> removedAges = removed.get(AGE);
+    ages.insert(ages.end(), removedAges.begin(), removedAges.end());
+    std::sort(ages.begin(), ages.end());
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(ages[i], i);
+    }
+}
@@ -1,10 +1,12 @@
+#include <algorithm>
+#include <cmath>
 #include <gtest/gtest.h>
 #include "../../main/model/Group.h"
 
 
 TEST(GroupTest, GroupReassignBreeders) {
     //given
-    Group group;
+    Group group(std::make_shared<Parameters>("unit_tests.yml", 0));
     int newBreederOutsider = 0, newBreederInsider = 0, inheritance = 0;
     int deaths = 0;
     group.calculateGroupSize();
@@ -27,7 +29,7 @@ TEST(GroupTest, GroupReassignBreeders) {
 
 TEST(GroupTest, GroupReassignBreedersStaySameSize) {
     //given
-    Group group;
+    Group group(std::make_shared<Parameters>("unit_tests.yml", 0));
     int newBreederOutsider = 0, newBreederInsider = 0, inheritance = 0;
     group.calculateGroupSize();
     const int initialGroupSize = group.getGroupSize();
@@ -44,9 +46,37 @@ TEST(GroupTest, GroupReassignBreedersStaySameSize) {
     }
 }
 
+TEST(GroupTest, SubordinateBreedersStayInTheMembers) {
+    //given
+    Group group(std::make_shared<Parameters>("unit_tests.yml", 0));
+    int newBreederOutsider = 0, newBreederInsider = 0, inheritance = 0;
+
+    //when
+    group.transferBreedersToHelpers();
+    const size_t members = group.getMembers().size();
+    group.reassignBreeders(newBreederOutsider, newBreederInsider, inheritance);
+
+    //then
+    const IndividualStore &store = group.getMembers();
+    const RoleType *roles = store.roles();
+    EXPECT_EQ(store.size(), members - 1); // only the main breeder leaves
+    EXPECT_EQ(std::count(roles, roles + store.size(), BREEDER), group.getSubordinateBreedersSize());
+    EXPECT_EQ(group.getHelpers().size() + group.getSubordinateBreeders().size(), store.size());
+
+    //when
+    group.transferBreedersToHelpers();
+
+    //then
+    EXPECT_EQ(group.getMembers().size(), members);
+    EXPECT_EQ(group.getSubordinateBreedersSize(), 0);
+    EXPECT_EQ(group.getHelpers().size(), members);
+}
+
 TEST(GroupTest, OffspringProduction) {
     //given
-    Group group;
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    Group group(parameters);
+    MutationEngine mutation(*parameters);
     int initialGroupSize, groupSizeAfterReproduction;
     int fecundity;
     int newBreederOutsider = 0, newBreederInsider = 0, inheritance = 0;
@@ -56,7 +86,7 @@ TEST(GroupTest, OffspringProduction) {
         initialGroupSize = group.getGroupSize();
         group.transferBreedersToHelpers();
         group.reassignBreeders(newBreederOutsider, newBreederInsider, inheritance);
-        group.reproduce(i, 1);
+        group.reproduce(i, 1, mutation);
         fecundity = group.getFecundityGroup();
         group.calculateGroupSize();
         groupSizeAfterReproduction = group.getGroupSize();
@@ -64,4 +94,218 @@ TEST(GroupTest, OffspringProduction) {
         EXPECT_EQ(groupSizeAfterReproduction, initialGroupSize + fecundity);
         EXPECT_EQ(group.getFecundityGroup(), group.getOffspringMainBreeder() + group.getOffspringSubordinateBreeders());
     }
-}
\ No newline at end of file
+}
+
+TEST(GroupTest, AggregatesMatchARecomputationAfterEveryPhase) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    Group group(parameters);
+    MutationEngine mutation(*parameters);
+    IndividualStore floaters;
+    for (int i = 0; i < 20; i++) {
+        floaters.push_back(Individual(FLOATER, *parameters));
+    }
+    int newBreederOutsider = 0, newBreederInsider = 0, inheritance = 0, deaths = 0;
+    ASSERT_TRUE(group.hasConsistentAggregates());
+
+    for (int generation = 1; generation <= 20; generation++) {
+        group.setGeneration(generation);
+
+        //when
+        group.disperse(floaters);
+        //then
+        ASSERT_TRUE(group.hasConsistentAggregates()) << "dispersal, generation " << generation;
+
+        //when
+        group.acceptFloaters(floaters);
+        //then
+        ASSERT_TRUE(group.hasConsistentAggregates()) << "immigration, generation " << generation;
+
+        //when
+        group.reassignBreeders(newBreederOutsider, newBreederInsider, inheritance);
+        //then
+        ASSERT_TRUE(group.hasConsistentAggregates()) << "breeder reassignment, generation " << generation;
+
+        //when
+        group.calculateCumulativeHelp();
+        group.survivalGroup();
+        group.mortalityGroup(deaths);
+        //then
+        ASSERT_TRUE(group.hasConsistentAggregates()) << "mortality, generation " << generation;
+
+        //when
+        group.increaseAge();
+        group.reproduce(generation, 1, mutation);
+        //then
+        ASSERT_TRUE(group.hasConsistentAggregates()) << "reproduction, generation " << generation;
+    }
+    EXPECT_GT(deaths, 0);
+    EXPECT_GT(newBreederOutsider + newBreederInsider, 0);
+}
+
+TEST(GroupTest, ScrambleReassignBreedersStaySameSize) {
+    //given
+    Group group(std::make_shared<Parameters>("unit_tests_scramble.yml", 0));
+    int newBreederOutsider = 0, newBreederInsider = 0, inheritance = 0;
+    group.calculateGroupSize();
+    const int initialGroupSize = group.getGroupSize();
+
+    //when
+    for (int i = 0; i < 100; i++) {
+        group.transferBreedersToHelpers();
+        group.reassignBreeders(newBreederOutsider, newBreederInsider, inheritance);
+        group.calculateGroupSize();
+        group.survivalGroup();
+        //then
+        EXPECT_EQ(group.getGroupSize(), initialGroupSize);
+        EXPECT_TRUE(group.isBreederAlive());
+    }
+    EXPECT_GE(newBreederOutsider + newBreederInsider, 100);
+}
+
+TEST(GroupTest, AcceptedFloatersLeaveTheFloaters) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    Group group(parameters);
+    group.transferBreedersToHelpers();
+    const size_t members = group.getMembers().size();
+    IndividualStore floaters;
+    for (int i = 0; i < 50; i++) {
+        floaters.push_back(Individual(FLOATER, *parameters));
+        floaters.back().setGroupIndex(-1 - i); // tags the floater
+    }
+
+    //when
+    group.acceptFloaters(floaters);
+
+    //then
+    const IndividualStore &accepted = group.getMembers();
+    const size_t immigrants = accepted.size() - members;
+    EXPECT_EQ(immigrants, std::lround(5 * group.getAcceptanceRate())); // FLOATERS_SAMPLED_IMMIGRATION: 5
+    EXPECT_EQ(immigrants + floaters.size(), 50);
+    std::vector<int> tags;
+    for (size_t i = members; i < accepted.size(); i++) {
+        EXPECT_EQ(accepted[i].getRoleType(), HELPER);
+        tags.push_back(-1 - accepted[i].getGroupIndex());
+    }
+    for (size_t i = 0; i < floaters.size(); i++) {
+        tags.push_back(-1 - floaters[i].getGroupIndex());
+    }
+    std::sort(tags.begin(), tags.end());
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(tags[i], i);
+    }
+}
+
+namespace {
+    // Counts the allocations made from the scratch resource of a group, where intermediate stores would come from
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        int allocations = 0;
+
+    private:
+        void *do_allocate(size_t bytes, size_t alignment) override {
+            allocations++;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+            std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    // Sorted ids of the rows of some stores: a row that was copied and not removed from its source shows up twice
+    std::vector<int> ids(std::initializer_list<const IndividualStore *> stores) {
+        std::vector<int> result;
+        for (const IndividualStore *store: stores) {
+            for (auto individual: *store) {
+                result.push_back(individual.getId());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    IndividualStore makeFloaters(Parameters &parameters, int count) {
+        IndividualStore floaters;
+        floaters.reserve(100); // a copy into reserved space would not allocate
+        for (int i = 0; i < count; i++) {
+            floaters.push_back(Individual(FLOATER, parameters));
+        }
+        return floaters;
+    }
+}
+
+TEST(GroupTest, DispersersAreNotCopiedOnTheWay) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    CountingResource scratch;
+    Group group(parameters, &scratch);
+    IndividualStore floaters = makeFloaters(*parameters, 10);
+    const IndividualStore &members = group.getMembers();
+    const size_t membersBefore = members.size(), floatersBefore = floaters.size();
+    const std::vector<int> idsBefore = ids({&members, &floaters});
+    scratch.allocations = 0;
+
+    //when
+    group.disperse(floaters);
+
+    //then
+    const size_t moved = membersBefore - members.size();
+    EXPECT_GT(moved, 0);
+    EXPECT_EQ(floaters.size(), floatersBefore + moved);
+    EXPECT_EQ(ids({&members, &floaters}), idsBefore);
+    for (size_t i = floatersBefore; i < floaters.size(); i++) {
+        EXPECT_EQ(floaters[i].getRoleType(), FLOATER);
+    }
+    EXPECT_LE(scratch.allocations, 2); // the uniform draws and the keep flags of the filter, no store
+}
+
+TEST(GroupTest, ReassignedHelpersAreNotCopiedOnTheWay) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests_norel.yml", 0);
+    CountingResource scratch;
+    Group group(parameters, &scratch, 1);
+    IndividualStore reassigned = makeFloaters(*parameters, 0);
+    const IndividualStore &members = group.getMembers();
+    const size_t membersBefore = members.size();
+    const std::vector<int> idsBefore = ids({&members, &reassigned});
+    scratch.allocations = 0;
+
+    //when
+    const size_t moved = group.noRelatedHelpersToReassign(1, reassigned);
+
+    //then
+    EXPECT_GT(moved, 0);
+    EXPECT_EQ(members.size(), membersBefore - moved);
+    EXPECT_EQ(reassigned.size(), moved);
+    EXPECT_EQ(ids({&members, &reassigned}), idsBefore);
+    EXPECT_EQ(scratch.allocations, 0);
+}
+
+TEST(GroupTest, ImmigrantsAreNotCopiedOnTheWay) {
+    //given
+    auto parameters = std::make_shared<Parameters>("unit_tests.yml", 0);
+    CountingResource scratch;
+    Group group(parameters, &scratch);
+    IndividualStore floaters = makeFloaters(*parameters, 50);
+    const IndividualStore &members = group.getMembers();
+    group.transferBreedersToHelpers(); // done by the acceptance, so that the main breeder is not counted as moved
+    const size_t membersBefore = members.size(), floatersBefore = floaters.size();
+    const std::vector<int> idsBefore = ids({&members, &floaters});
+    scratch.allocations = 0;
+
+    //when
+    group.acceptFloaters(floaters);
+
+    //then
+    const size_t moved = floatersBefore - floaters.size();
+    EXPECT_GT(moved, 0);
+    EXPECT_EQ(members.size(), membersBefore + moved);
+    EXPECT_EQ(ids({&members, &floaters}), idsBefore);
+    EXPECT_EQ(scratch.allocations, 0);
+}
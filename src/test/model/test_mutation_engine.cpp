@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "../../main/model/MutationEngine.h"
+
+namespace {
+    size_t countMutatedAlphas(MutationEngine &mutation, Parameters &parameters, size_t batches, size_t batchSize) {
+        IndividualStore offspring;
+        for (size_t i = 0; i < batches * batchSize; i++) {
+            offspring.push_back(Individual(HELPER, parameters));
+        }
+        // mutate in several batches, as the groups of a generation do
+        IndividualStore batch;
+        size_t mutated = 0;
+        for (size_t b = 0; b < batches; b++) {
+            batch.clear();
+            for (size_t i = 0; i < batchSize; i++) {
+                batch.push_back(offspring, b * batchSize + i);
+            }
+            mutation.mutate(batch, 0, *parameters.getGenerator());
+            for (size_t i = 0; i < batchSize; i++) {
+                mutated += batch.alphas()[i] != offspring.alphas()[b * batchSize + i];
+            }
+        }
+        return mutated;
+    }
+}
+
+TEST(MutationEngineTest, MutationRateOfAlpha) {
+    //given
+    Parameters parameters("unit_tests.yml", 0);
+    MutationEngine mutation(parameters);
+
+    //when
+    mutation.setMutationAlpha(0);
+    size_t none = countMutatedAlphas(mutation, parameters, 10, 100);
+    mutation.setMutationAlpha(0.25);
+    size_t some = countMutatedAlphas(mutation, parameters, 2000, 7);
+
+    //then
+    EXPECT_EQ(none, 0);
+    EXPECT_NEAR(static_cast<double>(some) / 14000, 0.25, 0.02);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include "../../main/model/Population.h"
+
+
+TEST(PopulationTest, FusedGroupPassMatchesSeparatePhases) {
+    //given
+    Population separate(std::make_shared<Parameters>("unit_tests.yml", 0));
+    Population fused(std::make_shared<Parameters>("unit_tests.yml", 0));
+
+    //when
+    for (int generation = 1; generation <= 5; generation++) {
+        for (Population *population: {&separate, &fused}) {
+            population->reset(generation);
+            population->disperse();
+            population->survivalFloaters();
+            population->mortalityFloaters();
+            population->immigrate();
+            population->reassignBreeder();
+        }
+        separate.help();
+        separate.survivalGroup();
+        separate.mortalityGroup();
+        fused.helpSurvivalMortality();
+
+        //then
+        ASSERT_EQ(separate.getDeaths(), fused.getDeaths());
+        ASSERT_EQ(separate.getGroups().size(), fused.getGroups().size());
+        for (size_t i = 0; i < separate.getGroups().size(); i++) {
+            ASSERT_EQ(separate.getGroups()[i].getGroupSize(), fused.getGroups()[i].getGroupSize());
+            ASSERT_EQ(separate.getGroups()[i].getCumHelp(), fused.getGroups()[i].getCumHelp());
+        }
+
+        for (Population *population: {&separate, &fused}) {
+            population->increaseAge();
+            population->reproduce(generation);
+        }
+    }
+}
+
+TEST(PopulationTest, ActiveGroupsCoverEveryGroupWithMembers) {
+    //given
+    Population population(std::make_shared<Parameters>("unit_tests.yml", 0));
+
+    //when
+    for (int generation = 1; generation <= 5; generation++) {
+        population.reset(generation);
+        population.disperse();
+        population.survivalFloaters();
+        population.mortalityFloaters();
+        population.immigrate();
+        population.reassignBreeder();
+        population.help();
+        population.survivalGroup();
+        population.mortalityGroup();
+
+        //then
+        const std::vector<int> &active = population.getActiveGroups();
+        EXPECT_TRUE(std::is_sorted(active.begin(), active.end()));
+        for (size_t i = 0; i < population.getGroups().size(); i++) {
+            const bool listed = std::find(active.begin(), active.end(), static_cast<int>(i)) != active.end();
+            EXPECT_EQ(listed, !population.getGroups()[i].isEmpty()) << "group " << i;
+        }
+
+        population.increaseAge();
+        population.reproduce(generation);
+    }
+}
+
+TEST(PopulationTest, ReassignedHelpersLeaveTheirGroupAndKeepGroupSizes) {
+    int unevenDonations = 0, dominantDonations = 0;
+
+    for (int replica = 0; replica < 200; replica++) {
+        //given: NO_RELATEDNESS, so every helper that does not disperse (all of them are 1 year old) is reassigned
+        Population population(std::make_shared<Parameters>("unit_tests_norel.yml", replica));
+        const std::vector<Group> &groups = population.getGroups();
+        const int maxColonies = static_cast<int>(groups.size());
+
+        //when
+        population.reset(1);
+        population.disperse();
+
+        //then
+        // Reassigned helpers keep the index of the group that gave them, so the donations can be counted afterwards;
+        // a group gave all of its helpers that did not disperse, so its donation is its size before the reassignment
+        std::vector<int> donated(maxColonies, 0), received(maxColonies, 0), returned(maxColonies, 0);
+        for (int i = 0; i < maxColonies; i++) {
+            for (auto helper: groups[i].getMembers()) {
+                ASSERT_EQ(helper.getRoleType(), HELPER);
+                ASSERT_GE(helper.getGroupIndex(), 0);
+                donated[helper.getGroupIndex()]++;
+                received[i]++;
+                returned[i] += helper.getGroupIndex() == i;
+            }
+        }
+        const int total = std::accumulate(donated.begin(), donated.end(), 0);
+        const int largest = *std::max_element(donated.begin(), donated.end());
+        for (int i = 0; i < maxColonies; i++) {
+            EXPECT_EQ(received[i], donated[i]) << "replica " << replica << ", group " << i;
+        }
+        if (2 * largest > total) {
+            // One group gave more than half of the helpers: as few of them as possible go back to it
+            dominantDonations++;
+            const int dominant = static_cast<int>(std::max_element(donated.begin(), donated.end()) - donated.begin());
+            EXPECT_EQ(returned[dominant], 2 * largest - total) << "replica " << replica;
+            EXPECT_EQ(std::accumulate(returned.begin(), returned.end(), 0), returned[dominant]);
+        } else {
+            EXPECT_EQ(std::accumulate(returned.begin(), returned.end(), 0), 0) << "replica " << replica;
+            unevenDonations += *std::min_element(donated.begin(), donated.end()) < largest;
+        }
+    }
+    EXPECT_GT(unevenDonations, 0);
+    EXPECT_GT(dominantDonations, 0);
+}
+
+TEST(PopulationTest, ReassignedSiblingsAreSpreadOverTheReceivingGroups) {
+    int siblingPairs = 0, pairsTogether = 0;
+
+    for (int replica = 0; replica < 50; replica++) {
+        //given: NO_RELATEDNESS and enough groups that siblings can be sent to different ones
+        Population population(std::make_shared<Parameters>("unit_tests_norel_groups.yml", replica));
+        const std::vector<Group> &groups = population.getGroups();
+        const size_t maxColonies = groups.size();
+
+        //when
+        population.reset(1);
+        population.disperse();
+
+        //then
+        // sent[donor][receiver] counts the helpers that a donor group sent to a receiving group
+        std::vector<std::vector<int>> sent(maxColonies, std::vector<int>(maxColonies, 0));
+        std::vector<int> donated(maxColonies, 0);
+        for (size_t i = 0; i < maxColonies; i++) {
+            for (auto helper: groups[i].getMembers()) {
+                sent[helper.getGroupIndex()][i]++;
+                donated[helper.getGroupIndex()]++;
+            }
+        }
+        for (size_t donor = 0; donor < maxColonies; donor++) {
+            siblingPairs += donated[donor] * (donated[donor] - 1) / 2;
+            for (int helpers: sent[donor]) {
+                pairsTogether += helpers * (helpers - 1) / 2;
+            }
+        }
+    }
+
+    // Sent independently, two siblings end up in the same group about once in every maxColonies - 1 pairs; sent as
+    // one block, most of them would
+    ASSERT_GT(siblingPairs, 1000);
+    EXPECT_LT(pairsTogether, siblingPairs / 5);
+}
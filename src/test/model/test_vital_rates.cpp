@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "../../main/model/Individual.h"
+#include "../../main/model/VitalRates.h"
+
+
+TEST(VitalRatesTest, SurvivalMatchesFormula) {
+    //given
+    Parameters parameters("unit_tests.yml", 0);
+    const VitalRates &rates = parameters.getVitalRates();
+
+    for (RoleType role: {BREEDER, HELPER, FLOATER}) {
+        for (int groupSize: {0, 1, 7, 127, 128, 300}) {
+            for (bool hasPotentialImmigrants: {false, true}) {
+                //when
+                double expected = Individual::computeSurvival(parameters, role, groupSize, 0.3, -1.2, 0.7,
+                                                              hasPotentialImmigrants);
+                double actual = rates.survival(role, groupSize, 0.3, -1.2, 0.7, hasPotentialImmigrants);
+
+                //then
+                EXPECT_EQ(actual, expected);
+            }
+        }
+    }
+    EXPECT_EQ(rates.getFloaterSurvival(), Individual::computeSurvival(parameters, FLOATER, 5, 0, 0, 0, false));
+}
+
+TEST(VitalRatesTest, BatchSurvivalMatchesSingle) {
+    //given
+    Parameters parameters("unit_tests.yml", 0);
+    const VitalRates &rates = parameters.getVitalRates();
+    std::vector<Trait> helps{0, 0.5, 1, 3}, gammas{-2, 0, 0.1, 4}, survivals(4);
+
+    for (RoleType role: {BREEDER, HELPER, FLOATER}) {
+        //when
+        rates.survival(role, 9, helps.data(), gammas.data(), survivals.data(), survivals.size(), true);
+
+        //then
+        for (size_t i = 0; i < survivals.size(); i++) {
+            EXPECT_EQ(survivals[i], static_cast<Trait>(rates.survival(role, 9, helps[i], gammas[i], 0, true)));
+        }
+    }
+}
+
+TEST(VitalRatesTest, SubordinateBreederTerm) {
+    //given
+    Parameters parameters("unit_tests.yml", 0);
+    const VitalRates &rates = parameters.getVitalRates();
+
+    for (size_t breeders: {0, 1, 2, 200}) {
+        //then
+        EXPECT_EQ(rates.subordinateBreederTerm(breeders),
+                  parameters.getKnb() * breeders / (1 + breeders));
+    }
+}
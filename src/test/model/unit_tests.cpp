@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include "../../main/util/Parameters.h"
+#include "../../main/util/Config.h"
 
 int main(int count, char **argv) {
     testing::InitGoogleTest(&count, argv);
+    Config::loadConfig();
     return RUN_ALL_TESTS();
 }
\ No newline at end of file
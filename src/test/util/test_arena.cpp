@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include "../../main/util/Arena.h"
+
+namespace {
+    // Simulates the scratch use of one generation: a vector that grows one element at a time
+    const double *fillScratch(Arena &arena) {
+        std::pmr::vector<double> values(&arena);
+        for (int i = 0; i < 1000; i++) {
+            values.push_back(i);
+        }
+        return values.data();
+    }
+}
+
+TEST(ArenaTest, ResetReusesMemory) {
+    //given
+    Arena arena(1024);
+    fillScratch(arena);
+    arena.reset();
+    const size_t capacity = arena.capacity();
+
+    //when
+    const double *first = fillScratch(arena);
+    arena.reset();
+    const double *second = fillScratch(arena);
+
+    //then
+    EXPECT_EQ(arena.capacity(), capacity); // no growth once the arena holds a generation's working set
+    EXPECT_EQ(first, second);
+}
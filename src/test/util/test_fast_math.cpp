@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../../main/util/FastMath.h"
+
+TEST(FastMathTest, FastExpRelativeError) {
+    for (double x = -700; x <= 700; x += 0.173) {
+        double exact = std::exp(x);
+        EXPECT_LT(std::abs(fastExp(x) - exact) / exact, 1e-13) << "x = " << x;
+    }
+    EXPECT_EQ(fastExp(0), 1);
+    EXPECT_GT(fastExp(-1000), 0); // clamped, no underflow to 0
+}
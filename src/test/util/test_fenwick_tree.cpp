@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../../main/util/FenwickTree.h"
+
+TEST(FenwickTreeTest, FindsTheWeightIntervalOfATarget) {
+    //given
+    const std::vector<long> weights = {3, 0, 1, 4, 0, 2, 5};
+    FenwickTree tree(weights.size(), [&](size_t i) { return weights[i]; }, std::pmr::get_default_resource());
+
+    //then
+    ASSERT_EQ(tree.total(), 15);
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < weights.size(); i++) {
+        expected.insert(expected.end(), weights[i], i);
+    }
+    for (long target = 0; target < tree.total(); target++) {
+        EXPECT_EQ(tree.find(target), expected[target]) << "target " << target;
+    }
+}
+
+TEST(FenwickTreeTest, DrawWithoutReplacement) {
+    //given
+    const size_t size = 37;
+    FenwickTree tree(size, [](size_t i) { return static_cast<long>(i % 5); }, std::pmr::get_default_resource());
+    std::vector<bool> drawn(size);
+
+    //when removing the position in the middle of the remaining weight until none is left
+    while (tree.total() > 0) {
+        const size_t position = tree.find(tree.total() / 2);
+        ASSERT_FALSE(drawn[position]);
+        ASSERT_NE(position % 5, 0u);
+        drawn[position] = true;
+        tree.add(position, -static_cast<long>(position % 5));
+    }
+
+    //then every position with a weight was drawn once
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_EQ(drawn[i], i % 5 != 0) << "position " << i;
+    }
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../../main/util/Random.h"
+#include "../../main/util/Parameters.h"
+#include "../../main/util/UniformBuffer.h"
+
+namespace {
+    template<class Draw>
+    std::pair<double, double> meanAndVariance(Draw draw, int count) {
+        double sum = 0, sumSquares = 0;
+        for (int i = 0; i < count; i++) {
+            double value = draw();
+            sum += value;
+            sumSquares += value * value;
+        }
+        double mean = sum / count;
+        return {mean, sumSquares / count - mean * mean};
+    }
+}
+
+TEST(RandomTest, Moments) {
+    RandomEngine engine(1);
+    const int count = 200000;
+
+    auto uniform = meanAndVariance([&] { return Random::uniform(engine); }, count);
+    EXPECT_NEAR(uniform.first, 0.5, 0.005);
+    EXPECT_NEAR(uniform.second, 1.0 / 12, 0.002);
+
+    auto normal = meanAndVariance([&] { return Random::normal(engine); }, count);
+    EXPECT_NEAR(normal.first, 0, 0.01);
+    EXPECT_NEAR(normal.second, 1, 0.01);
+
+    for (double mean: {0.3, 4.0, 12.5, 80.0}) {
+        auto poisson = meanAndVariance([&] { return Random::poisson(engine, mean); }, count);
+        EXPECT_NEAR(poisson.first, mean, 0.01 * mean + 0.01) << "mean " << mean;
+        EXPECT_NEAR(poisson.second, mean, 0.03 * mean + 0.01) << "mean " << mean;
+    }
+
+    for (auto [trials, probability]: {std::pair{5, 0.3}, {40, 0.1}, {30, 0.8}, {2000, 0.03}, {100000, 0.4}}) {
+        auto binomial = meanAndVariance([&] { return Random::binomial(engine, trials, probability); }, count);
+        const double mean = trials * probability, variance = mean * (1 - probability);
+        EXPECT_NEAR(binomial.first, mean, 5 * std::sqrt(variance / count)) << trials << " trials, p " << probability;
+        EXPECT_NEAR(binomial.second, variance, 0.03 * variance) << trials << " trials, p " << probability;
+    }
+
+    const double p = 0.06;
+    auto geometric = meanAndVariance([&] { return Random::geometric(engine, std::log1p(-p)); }, count);
+    EXPECT_NEAR(geometric.first, (1 - p) / p, 0.2);
+}
+
+TEST(RandomTest, BoundedStaysInRange) {
+    RandomEngine engine(1);
+    std::vector<int> counts(7);
+    for (int i = 0; i < 70000; i++) {
+        int value = Random::uniformInt(engine, 3, 9);
+        ASSERT_GE(value, 3);
+        ASSERT_LE(value, 9);
+        counts[value - 3]++;
+    }
+    for (int count: counts) {
+        EXPECT_NEAR(count, 10000, 400);
+    }
+}
+
+// Known answers of Philox4x32-10 from the Random123 distribution
+TEST(RandomTest, PhiloxKnownAnswers) {
+    EXPECT_EQ(Philox::generate({0, 0, 0, 0}, {0, 0}), (Philox::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(Philox::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+              (Philox::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(Philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (Philox::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(RandomTest, StreamsAreIndependentOfDrawOrder) {
+    Parameters parameters("unit_tests.yml", 0);
+
+    RandomEngine first = parameters.stream(7, 3, RandomPhase::MORTALITY);
+    RandomEngine other = parameters.stream(7, 4, RandomPhase::MORTALITY);
+    const uint64_t value = first();
+    for (int i = 0; i < 10; i++) {
+        other();
+    }
+
+    EXPECT_EQ(parameters.stream(7, 3, RandomPhase::MORTALITY)(), value);
+    EXPECT_NE(parameters.stream(7, 3, RandomPhase::DISPERSAL)(), value);
+    EXPECT_NE(parameters.stream(8, 3, RandomPhase::MORTALITY)(), value);
+    EXPECT_NE(Parameters("unit_tests.yml", 1).stream(7, 3, RandomPhase::MORTALITY)(), value);
+}
+
+// The samplers only depend on the engine output, so these values must not change with the compiler or the standard
+// library
+TEST(RandomTest, BufferedUniformsMatchTheEngine) {
+    RandomEngine reference(7, 1, 2, 3);
+    RandomEngine bulk(reference);
+    reference();
+    bulk();
+    std::vector<RandomEngine::result_type> bits(21);
+    bulk.fill(bits.data(), bits.size());
+    for (auto value: bits) {
+        ASSERT_EQ(value, reference());
+    }
+    EXPECT_EQ(bulk(), reference());
+
+    UniformBuffer uniforms(reference);
+    for (int i = 0; i < 3 * UniformBuffer::BLOCK + 5; i++) {
+        ASSERT_EQ(uniforms(), Random::uniform(reference));
+    }
+}
+
+TEST(RandomTest, ReproducibleSequence) {
+    RandomEngine engine(1);
+    EXPECT_EQ(engine(), 16504019988892878448ULL);
+    EXPECT_EQ(Random::uniformInt(engine, 0, 999), 711);
+    EXPECT_EQ(Random::poisson(engine, 3.5), 6);
+    EXPECT_EQ(Random::poisson(engine, 40), 43);
+    EXPECT_EQ(Random::normal(engine), 2.0733867302603008);
+}